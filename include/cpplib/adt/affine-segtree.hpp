@@ -0,0 +1,130 @@
+#pragma once
+#include <cpplib/adt/modular.hpp>
+#include <cpplib/adt/segtreeb.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Affine Lazy.
+ *
+ * Represents the function f(x) = a*x + b,
+ * which is closed under composition, so
+ * that range multiplications, additions
+ * and sets can share the same lazy.
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(1).
+ */
+template<typename T>
+struct STAffineLazy
+{
+    T a = 1, b = 0;
+
+    /**
+     * Composes delta after the current
+     * function, i.e. x -> delta(f(x)).
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    STAffineLazy &operator+=(const STAffineLazy &delta)
+    {
+        a *= delta.a;
+        b = b * delta.a + delta.b;
+        return *this;
+    }
+
+    bool operator!=(const STAffineLazy &rhs) const
+    {
+        return a != rhs.a or b != rhs.b;
+    }
+};
+
+/**
+ * Affine Segment Tree Node.
+ *
+ * Keeps the sum of the range, which an
+ * affine function maps to a*sum + b*range.
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(1).
+ */
+template<typename T>
+struct STAffineNode : STNodeB<STAffineNode<T>, T, STAffineLazy<T> >
+{
+    using super_type = STNodeB<STAffineNode<T>, T, STAffineLazy<T> >;
+
+    STAffineNode() :
+        super_type(0) {}
+
+    STAffineNode(const T value) :
+        super_type(value) {}
+
+    STAffineNode(const STAffineNode &lhs, const STAffineNode &rhs) :
+        super_type(lhs.value + rhs.value) {}
+
+    void update(const size_t range)
+    {
+        this->value = this->lazy.a * this->value + this->lazy.b * T(range);
+        this->lazy = STAffineLazy<T>();
+    }
+};
+
+/**
+ * Affine Segment Tree.
+ *
+ * Segment Tree with range affine updates
+ * (a[i] = a*a[i] + b) and range sum
+ * queries, meant for modular values. With
+ * montgomery<M> values (e.g. MOD 998244353)
+ * neither the composition of the lazies nor
+ * the nodes need any division by M.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename T>
+class AffineSegTree : public SegTreeB<STAffineNode<T>, T>
+{
+public:
+    AffineSegTree() :
+        AffineSegTree(1) {}
+
+    AffineSegTree(const size_t arr_size) :
+        super_type(arr_size, vector<T>(arr_size, 0)) {}
+
+    AffineSegTree(const vector<T> &arr) :
+        super_type(arr) {}
+
+    AffineSegTree(const size_t arr_size, const vector<T> &arr) :
+        super_type(arr_size, arr) {}
+
+    /**
+     * Applies a[i] = a*a[i] + b to the range
+     * [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void affine(const size_t l, const size_t r, const T a, const T b)
+    {
+        this->update(l, r, STAffineLazy<T>{a, b});
+    }
+
+    /**
+     * Sets the array values in the range
+     * [l, r] to value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void set(const size_t l, const size_t r, const T value)
+    {
+        affine(l, r, 0, value);
+    }
+
+private:
+    using super_type = SegTreeB<STAffineNode<T>, T>;
+};
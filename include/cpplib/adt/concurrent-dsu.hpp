@@ -0,0 +1,193 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Concurrent Disjoint Set Union.
+ *
+ * Lock-free Disjoint Set Union, so that any
+ * number of threads can merge, find and
+ * check elements at the same time. Roots
+ * are linked with a compare-and-swap by a
+ * fixed random priority of their indices
+ * (the root with the lower priority goes
+ * under the other one, so no cycles can
+ * appear), and find does path splitting,
+ * also with compare-and-swaps that may fail
+ * harmlessly.
+ *
+ * Note: the set sizes are moved up to the
+ * new root after each link, so size(x) is
+ * exact once the merges running
+ * concurrently are done.
+ *
+ * Time Complexity: O(n + m*log(n)).
+ * Space Complexity: O(n).
+ * Where n is the number of elements and m is the number of links between them.
+ */
+class ConcurrentDSU
+{
+public:
+    ConcurrentDSU(const int set_size) :
+        nodes(set_size), set_size(set_size), cnt(set_size)
+    {
+        for(int i = 0; i < set_size; ++i) {
+            nodes[i].root.store(i, memory_order_relaxed);
+            nodes[i].sz.store(1, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Merges all the links, split among the
+     * given number of threads.
+     *
+     * Time Complexity: O(n + m*log(n)/threads).
+     * Space Complexity: O(n + threads).
+     * Where n is the number of elements and m is the number of links.
+     */
+    ConcurrentDSU(const int set_size, const vector<pair<int, int> > &links, const size_t threads = 1) :
+        ConcurrentDSU(set_size)
+    {
+        assert(threads > 0);
+        vector<thread> workers;
+        for(size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                for(size_t i = t * links.size() / threads; i < (t + 1) * links.size() / threads; ++i)
+                    merge(links[i].first, links[i].second);
+            });
+        for(thread &worker: workers)
+            worker.join();
+    }
+
+    ConcurrentDSU(ConcurrentDSU &&rhs) :
+        nodes(move(rhs.nodes)), set_size(rhs.set_size), cnt(rhs.cnt.load()) {}
+
+    /**
+     * Finds the element that represents
+     * the set containing x.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    int find(int x)
+    {
+        assert(0 <= x and x < set_size);
+        for(int p = nodes[x].root.load(); p != x; p = nodes[x].root.load()) {
+            int gp = nodes[p].root.load();
+            if(p != gp)
+                nodes[x].root.compare_exchange_weak(p, gp);
+            x = p;
+        }
+        return x;
+    }
+
+    /**
+     * Merges the sets containing a and b.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    bool merge(int a, int b)
+    {
+        assert(0 <= a and a < set_size);
+        assert(0 <= b and b < set_size);
+        while(true) {
+            a = find(a);
+            b = find(b);
+
+            if(a == b)
+                return false;
+
+            if(priority(a) < priority(b))
+                swap(a, b);
+
+            int expected = b;
+            if(nodes[b].root.compare_exchange_strong(expected, a))
+                break;
+        }
+
+        cnt.fetch_sub(1);
+        move_size(b);
+        return true;
+    }
+
+    /**
+     * Checks if two elements are in the same set.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    bool same(int a, int b)
+    {
+        assert(0 <= a and a < set_size);
+        assert(0 <= b and b < set_size);
+        while(true) {
+            a = find(a);
+            b = find(b);
+            if(a == b)
+                return true;
+            // a was still a root after b was found, so they were apart then.
+            if(nodes[a].root.load() == a)
+                return false;
+        }
+    }
+
+    /**
+     * Returns the number of disjoint sets.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    int size() const
+    {
+        return cnt.load();
+    }
+
+    /**
+     * Returns the size of the set containing x.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    int size(const int x)
+    {
+        return nodes[find(x)].sz.load();
+    }
+
+private:
+    // a bijection of the indices, so the linking order is random but fixed.
+    static uint64_t priority(const uint64_t x)
+    {
+        uint64_t z = x * 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    // moves the size kept at x (no longer a root) up, until it reaches a
+    // root which is still a root after the addition, so that a concurrent
+    // link of that root moves it along.
+    void move_size(int x)
+    {
+        for(int p = nodes[x].root.load(); p != x; p = nodes[x].root.load()) {
+            int value = nodes[x].sz.exchange(0);
+            if(value == 0)
+                return;
+            nodes[p].sz.fetch_add(value);
+            x = p;
+        }
+    }
+
+    // the size next to the parent, so they share the cache line.
+    struct Node
+    {
+        atomic<int> root, sz;
+    };
+
+    vector<Node> nodes;
+    int set_size;
+    atomic<int> cnt;
+};
@@ -0,0 +1,160 @@
+#pragma once
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Concurrent Segment Tree.
+ *
+ * Iterative (bottom-up) Segment Tree of
+ * atomics for the commutative Range Sum,
+ * Xor, Min and Max Query kinds, so that any
+ * number of threads can query and update it
+ * at the same time without locks. Queries
+ * only load the nodes (wait-free), sum and
+ * xor updates apply the delta to each node
+ * of the path with a single atomic
+ * operation, and min and max updates
+ * refresh each node of the path with
+ * compare-and-swaps until a read of the
+ * node matches its children read after it.
+ * Every write to a node is followed by such
+ * a check of its writer, so the last check
+ * of each node sees its final children and
+ * the tree is exact once the updates are
+ * done (even if a stale compare-and-swap
+ * went through in between).
+ *
+ * Note: a query running alongside updates
+ * sees each of them either fully or not at
+ * all in every node it visits.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<STKind K, typename T>
+class ConcurrentSegTree
+{
+    static_assert(K == RSumQ or K == RXorQ or K == RMinQ or K == RMaxQ, "only commutative kinds are supported.");
+    static_assert(atomic<T>::is_always_lock_free, "T must be lock-free.");
+
+public:
+    ConcurrentSegTree(const size_t arr_size = 1) :
+        ConcurrentSegTree(arr_size, vector<T>(arr_size, neutral_value<T>(K))) {}
+
+    ConcurrentSegTree(const vector<T> &arr) :
+        ConcurrentSegTree(arr.size(), arr) {}
+
+    ConcurrentSegTree(const size_t arr_size, const vector<T> &arr) :
+        tree(2 * arr_size), arr_size(arr_size)
+    {
+        assert(arr_size > 0 and arr_size <= arr.size());
+        for(size_t i = 0; i < arr_size; ++i)
+            tree[arr_size + i].store(arr[i], memory_order_relaxed);
+        for(size_t i = arr_size - 1; i > 0; --i)
+            tree[i].store(merge_values<T>(K, load(2 * i), load(2 * i + 1)), memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    T query(const size_t i) const
+    {
+        assert(i < arr_size);
+        return load(arr_size + i);
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(size_t l, size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        T res = neutral_value<T>(K);
+        for(l += arr_size, r += arr_size + 1; l < r; l /= 2, r /= 2) {
+            if(l & 1)
+                res = merge_values<T>(K, res, load(l++));
+            if(r & 1)
+                res = merge_values<T>(K, res, load(--r));
+        }
+        return res;
+    }
+
+    /**
+     * Updates the ith array value according to
+     * the SegmentTreeKind (i.e. adds delta,
+     * or xors it for RXorQ).
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(const size_t i, const T delta)
+    {
+        assert(i < arr_size);
+        size_t pos = arr_size + i;
+        if(K == RXorQ) {
+            for(; pos > 0; pos /= 2)
+                tree[pos].fetch_xor(delta, memory_order_relaxed);
+        }
+        else if(K == RSumQ) {
+            for(; pos > 0; pos /= 2)
+                tree[pos].fetch_add(delta, memory_order_relaxed);
+        }
+        else {
+            tree[pos].fetch_add(delta);
+            for(pos /= 2; pos > 0; pos /= 2)
+                refresh(pos);
+        }
+    }
+
+    /**
+     * Returns the number of node refreshes
+     * (min and max kinds) which lost their
+     * compare-and-swap to another writer,
+     * i.e. how contended the updates are.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t contention() const
+    {
+        return failed_refreshes.load(memory_order_relaxed);
+    }
+
+private:
+    T load(const size_t pos) const
+    {
+        return tree[pos].load(memory_order_relaxed);
+    }
+
+    // recomputes pos from its children until they agree. The children are
+    // read in separate loads, so the value may be stale, and the
+    // compare-and-swap may accept it if pos went back to old meanwhile,
+    // hence the check again after every write (the sequentially consistent
+    // order is what makes the last check see the final children).
+    void refresh(const size_t pos)
+    {
+        while(true) {
+            T old = tree[pos].load();
+            T value = merge_values<T>(K, tree[2 * pos].load(), tree[2 * pos + 1].load());
+            if(old == value)
+                return;
+            if(!tree[pos].compare_exchange_strong(old, value))
+                failed_refreshes.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    vector<atomic<T> > tree;
+    size_t arr_size;
+    atomic<size_t> failed_refreshes{0};
+};
@@ -110,3 +110,138 @@ private:
     vector<int> root, sz;
     int set_size, cnt;
 };
+
+/**
+ * Rollback Disjoint Set Union.
+ *
+ * Disjoint Set Union with union by size
+ * and no path compression, so that every
+ * merge changes only one root and can be
+ * undone, back to any snapshot.
+ *
+ * Time Complexity: O(n + m*log(n)).
+ * Space Complexity: O(n + m).
+ * Where n is the number of elements and m is the number of links between them.
+ */
+class RollbackDSU
+{
+public:
+    RollbackDSU(const int set_size) :
+        root(set_size), sz(set_size, 1), set_size(set_size), cnt(set_size)
+    {
+        iota(all(root), 0);
+    }
+
+    /**
+     * Finds the element that represents
+     * the set containing x.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    int find(int x) const
+    {
+        assert(0 <= x and x < set_size);
+        while(root[x] != x)
+            x = root[x];
+        return x;
+    }
+
+    /**
+     * Merges the sets containing a and b.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    bool merge(int a, int b)
+    {
+        a = find(a);
+        b = find(b);
+
+        if(a == b)
+            return false;
+
+        if(sz[a] < sz[b])
+            swap(a, b);
+
+        root[b] = a;
+        sz[a] += sz[b];
+        history.emplace_back(b);
+
+        cnt--;
+        return true;
+    }
+
+    /**
+     * Checks if two elements are in the same set.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    bool same(const int a, const int b) const
+    {
+        return find(a) == find(b);
+    }
+
+    /**
+     * Returns the number of disjoint sets.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    int size() const
+    {
+        return cnt;
+    }
+
+    /**
+     * Returns the size of the set containing x.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the number of tracked elements.
+     */
+    int size(const int x) const
+    {
+        return sz[find(x)];
+    }
+
+    /**
+     * Returns the current version, to be
+     * given later to rollback.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t snapshot() const
+    {
+        return history.size();
+    }
+
+    /**
+     * Undoes the merges done after the
+     * given snapshot, in reverse order.
+     *
+     * Time Complexity: O(k).
+     * Space Complexity: O(1).
+     * Where k is the number of undone merges.
+     */
+    void rollback(const size_t version)
+    {
+        assert(version <= history.size());
+        while(history.size() > version) {
+            int b = history.back();
+            history.pop_back();
+            sz[root[b]] -= sz[b];
+            root[b] = b;
+            cnt++;
+        }
+    }
+
+private:
+    vector<int> root, sz, history;
+    int set_size, cnt;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <cpplib/adt/dynamic-segtreeb.hpp>
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/adt/segtrees.hpp>
+#include <cpplib/stdinc.hpp>
+
+template<STKind K, typename T>
+using DynamicSegTree = DynamicSegTreeB<STNode<K, T>, T>;
+
+template<STKind K, typename T>
+using DynamicSegTreeS = DynamicSegTreeSB<STNodeS<K, T>, T>;
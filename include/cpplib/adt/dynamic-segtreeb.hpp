@@ -0,0 +1,346 @@
+#pragma once
+#include <cpplib/adt/segtreeb.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Dynamic Segment Tree Base.
+ *
+ * Segment Tree over a huge implicit array
+ * (e.g. the range [0, 2^62)) whose nodes are
+ * only created when an update reaches
+ * them, so there is no need to compress the
+ * coordinates offline. The nodes are taken
+ * from a pool (a single vector) and refer
+ * to their children by 32 bits indices.
+ *
+ * Note: the array starts filled with the
+ * neutral value (Node()), and the missing
+ * children are represented by the sentinel
+ * node 0 which is never modified.
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(u*log(n)).
+ * Where n is the size of the array and u is the number of updates.
+ */
+template<typename Node, typename T>
+class DynamicSegTreeB
+{
+public:
+    using lazy_type = typename Node::lazy_type;
+
+    DynamicSegTreeB(const size_t arr_size = size_t(1) << 62) :
+        cells(2), arr_size(arr_size)
+    {
+        assert(arr_size > 0);
+    }
+
+    /**
+     * Reserves space in the pool for the
+     * given number of nodes.
+     *
+     * Time Complexity: O(m).
+     * Space Complexity: O(m).
+     * Where m is the number of nodes.
+     */
+    void reserve(const size_t nodes)
+    {
+        cells.reserve(nodes + 2);
+    }
+
+    /**
+     * Returns the number of created nodes.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t nodes() const
+    {
+        return cells.size() - 1;
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element over the array that
+     * matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, const bool leftmost = true) const
+    {
+        return find(value, 0, arr_size - 1, leftmost);
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element in the range [l, r] of the
+     * array that matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value in the range [l, r].
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, const size_t l, const size_t r, const bool leftmost = true) const
+    {
+        assert(l <= r and r < arr_size);
+        if(!query(0, arr_size - 1, l, r, 1, cells[1].node).match(value))  // not found.
+            return arr_size;
+        return find(0, arr_size - 1, l, r, 1, cells[1].node, value, leftmost);
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    T query(const size_t i) const
+    {
+        assert(i < arr_size);
+        return query(i, i);
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    T query(const size_t l, const size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        return query(0, arr_size - 1, l, r, 1, cells[1].node).value;
+    }
+
+    /**
+     * Updates the ith array value according to
+     * the node implementation.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void update(const size_t i, const lazy_type delta)
+    {
+        assert(i < arr_size);
+        update(i, i, delta);
+    }
+
+    /**
+     * Updates the array values in the range
+     * [l, r] according to the node
+     * implementation.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void update(const size_t l, const size_t r, const lazy_type delta)
+    {
+        assert(l <= r and r < arr_size);
+        update(0, arr_size - 1, l, r, 1, delta);
+    }
+
+protected:
+    struct Cell
+    {
+        Node node;
+        uint32_t left = 0, right = 0;
+    };
+
+    // returns the left (or right) child of pos, creating it if needed.
+    uint32_t child(const uint32_t pos, const bool right)
+    {
+        uint32_t &c = (right ? cells[pos].right : cells[pos].left);
+        if(c == 0) {
+            assert(cells.size() < numeric_limits<uint32_t>::max());
+            c = uint32_t(cells.size());
+            cells.emplace_back();
+        }
+        return right ? cells[pos].right : cells[pos].left;
+    }
+
+    // the reads get the node of pos with the pending lazies of its
+    // ancestors, so they don't propagate (nor create the missing children,
+    // which are read as the sentinel).
+    size_t find(const size_t l, const size_t r, const size_t i, const size_t j, const uint32_t pos, const Node &node, const T value, const bool leftmost) const
+    {
+        if(l >= i and r <= j and !evaluate(l, r, node).match(value))
+            return arr_size;
+
+        if(l == r)
+            return l;
+
+        size_t mid = l + (r - l) / 2;
+        uint32_t left = cells[pos].left, right = cells[pos].right;
+        if(j <= mid)  // left.
+            return find(l, mid, i, j, left, pending(left, node), value, leftmost);
+        else if(i >= mid + 1)  // right.
+            return find(mid + 1, r, i, j, right, pending(right, node), value, leftmost);
+        else {
+            if(leftmost) {
+                size_t res = find(l, mid, i, j, left, pending(left, node), value, leftmost);  // left side.
+                if(res != arr_size)
+                    return res;
+                return find(mid + 1, r, i, j, right, pending(right, node), value, leftmost);  // right side.
+            }
+            else {
+                size_t res = find(mid + 1, r, i, j, right, pending(right, node), value, leftmost);  // right side.
+                if(res != arr_size)
+                    return res;
+                return find(l, mid, i, j, left, pending(left, node), value, leftmost);  // left side.
+            }
+        }
+    }
+
+    Node query(const size_t l, const size_t r, const size_t i, const size_t j, const uint32_t pos, const Node &node) const
+    {
+        if(l >= i and r <= j)
+            return evaluate(l, r, node);
+
+        size_t mid = l + (r - l) / 2;
+        uint32_t left = cells[pos].left, right = cells[pos].right;
+        if(j <= mid)  // left.
+            return query(l, mid, i, j, left, pending(left, node));
+        else if(i >= mid + 1)  // right.
+            return query(mid + 1, r, i, j, right, pending(right, node));
+        else  // both.
+            return Node(query(l, mid, i, j, left, pending(left, node)), query(mid + 1, r, i, j, right, pending(right, node)));
+    }
+
+    void update(const size_t l, const size_t r, const size_t i, const size_t j, const uint32_t pos, const lazy_type delta)
+    {
+        if(l >= i and r <= j) {
+            cells[pos].node.update_lazy(delta);
+            return;
+        }
+
+        propagate(l, r, pos);
+        size_t mid = l + (r - l) / 2;
+        if(i <= mid)  // left.
+            update(l, mid, i, j, child(pos, false), delta);
+        if(j >= mid + 1)  // right.
+            update(mid + 1, r, i, j, child(pos, true), delta);
+        pull(l, r, pos);
+    }
+
+    // a copy of the node of pos with the pending lazy of its parent node
+    // pushed into it.
+    Node pending(const uint32_t pos, const Node &parent) const
+    {
+        Node node = cells[pos].node;
+        if(parent.has_lazy())
+            parent.push(node);
+        return node;
+    }
+
+    // computes the node of the range [l, r] applying its lazy to a copy,
+    // so that the nodes which are fully covered don't create children.
+    static Node evaluate(const size_t l, const size_t r, Node node)
+    {
+        if(node.has_lazy())
+            node.update(r - l + 1);
+        return node;
+    }
+
+    // merges the child nodes of pos (which must have been propagated).
+    void pull(const size_t l, const size_t r, const uint32_t pos)
+    {
+        size_t mid = l + (r - l) / 2;
+        cells[pos].node = Node(evaluate(l, mid, cells[cells[pos].left].node), evaluate(mid + 1, r, cells[cells[pos].right].node));
+    }
+
+    void propagate(const size_t l, const size_t r, const uint32_t pos)
+    {
+        if(!cells[pos].node.has_lazy())
+            return;
+
+        if(l != r) {
+            // the children must be created before taking any reference.
+            uint32_t left = child(pos, false), right = child(pos, true);
+            cells[pos].node.push(cells[left].node);
+            cells[pos].node.push(cells[right].node);
+        }
+        cells[pos].node.update(r - l + 1);
+    }
+
+    vector<Cell> cells;
+    size_t arr_size;
+};
+
+/**
+ * Dynamic Segment Tree S Base.
+ *
+ * Note: this implementation only adds
+ * (range and point) set operations, NodeS
+ * must be a Segment Tree S Node.
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(u*log(n)).
+ * Where n is the size of the array and u is the number of updates.
+ */
+template<typename NodeS, typename T>
+class DynamicSegTreeSB : public DynamicSegTreeB<NodeS, T>
+{
+public:
+    DynamicSegTreeSB(const size_t arr_size = size_t(1) << 62) :
+        super_type(arr_size) {}
+
+    /**
+     * Sets the ith array value to value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void set(const size_t i, const T value)
+    {
+        assert(i < this->arr_size);
+        set(i, i, value);
+    }
+
+    /**
+     * Sets the array values in the range
+     * [l, r] to value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void set(const size_t l, const size_t r, const T value)
+    {
+        assert(l <= r and r < this->arr_size);
+        set(0, this->arr_size - 1, l, r, 1, value);
+    }
+
+private:
+    using super_type = DynamicSegTreeB<NodeS, T>;
+
+    void set(const size_t l, const size_t r, const size_t i, const size_t j, const uint32_t pos, const T value)
+    {
+        if(l >= i and r <= j) {
+            this->cells[pos].node.update_set(value);
+            return;
+        }
+
+        this->propagate(l, r, pos);
+        size_t mid = l + (r - l) / 2;
+        if(i <= mid)  // left.
+            set(l, mid, i, j, this->child(pos, false), value);
+        if(j >= mid + 1)  // right.
+            set(mid + 1, r, i, j, this->child(pos, true), value);
+        this->pull(l, r, pos);
+    }
+};
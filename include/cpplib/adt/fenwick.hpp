@@ -0,0 +1,486 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Fenwick Tree.
+ *
+ * Also known as Binary Indexed Tree, it
+ * stores partial sums of the array in a
+ * single vector so that it is possible to
+ * perform point updates and prefix/range
+ * sum queries effectively. It is a lighter
+ * alternative to SegTree<RSumQ, T> when
+ * only sums are needed.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename T>
+class Fenwick
+{
+public:
+    Fenwick(const size_t arr_size = 1) :
+        tree(arr_size + 1, 0), arr_size(arr_size) {}
+
+    Fenwick(const vector<T> &arr) :
+        Fenwick(arr.size(), arr) {}
+
+    Fenwick(const size_t arr_size, const vector<T> &arr) :
+        Fenwick(arr_size)
+    {
+        assert(arr_size <= arr.size());
+        for(size_t i = 1; i <= arr_size; ++i) {
+            tree[i] += arr[i - 1];
+            size_t j = i + (i & -i);
+            if(j <= arr_size)
+                tree[j] += tree[i];
+        }
+    }
+
+    /**
+     * Computes the sum of the range [0, r]
+     * of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T prefix(const size_t r) const
+    {
+        assert(r < arr_size);
+        T res = 0;
+        for(size_t i = r + 1; i > 0; i -= i & -i)
+            res += tree[i];
+        return res;
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t i) const
+    {
+        return query(i, i);
+    }
+
+    /**
+     * Computes the sum of the range [l, r]
+     * of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t l, const size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        return l == 0 ? prefix(r) : prefix(r) - prefix(l - 1);
+    }
+
+    /**
+     * Updates the ith array value adding
+     * delta to it.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(const size_t i, const T delta)
+    {
+        assert(i < arr_size);
+        for(size_t j = i + 1; j <= arr_size; j += j & -j)
+            tree[j] += delta;
+    }
+
+    /**
+     * Finds the first index i such that the
+     * sum of the range [0, i] is not less
+     * than value, it can be used to find the
+     * kth element when the array counts the
+     * elements.
+     *
+     * It returns the size of the array when
+     * there is no such index.
+     *
+     * Note: the array values must not be
+     * negative.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t lower_bound(T value) const
+    {
+        size_t pos = 0, pw = 1;
+        while(2 * pw <= arr_size)
+            pw *= 2;
+        for(; pw > 0; pw /= 2) {
+            if(pos + pw <= arr_size and tree[pos + pw] < value) {
+                pos += pw;
+                value -= tree[pos];
+            }
+        }
+        return pos;
+    }
+
+private:
+    vector<T> tree;
+    size_t arr_size;
+};
+
+/**
+ * Fenwick Tree RU.
+ *
+ * Fenwick Tree with range updates and
+ * range sum queries. It keeps a pair of
+ * Fenwick Trees over the differences of
+ * the array, so that the sum of the range
+ * [0, r] is b1(r)*(r + 1) - b2(r).
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename T>
+class FenwickRU
+{
+public:
+    FenwickRU(const size_t arr_size = 1) :
+        b1(arr_size), b2(arr_size), arr_size(arr_size) {}
+
+    FenwickRU(const vector<T> &arr) :
+        FenwickRU(arr.size(), arr) {}
+
+    FenwickRU(const size_t arr_size, const vector<T> &arr) :
+        arr_size(arr_size)
+    {
+        assert(arr_size <= arr.size());
+        vector<T> d1(arr_size), d2(arr_size);
+        for(size_t i = 0; i < arr_size; ++i) {
+            d1[i] = arr[i] - (i > 0 ? arr[i - 1] : 0);
+            d2[i] = d1[i] * T(i);
+        }
+        b1 = Fenwick<T>(d1);
+        b2 = Fenwick<T>(d2);
+    }
+
+    /**
+     * Computes the sum of the range [0, r]
+     * of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T prefix(const size_t r) const
+    {
+        assert(r < arr_size);
+        return b1.prefix(r) * T(r + 1) - b2.prefix(r);
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t i) const
+    {
+        assert(i < arr_size);
+        return b1.prefix(i);
+    }
+
+    /**
+     * Computes the sum of the range [l, r]
+     * of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t l, const size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        return l == 0 ? prefix(r) : prefix(r) - prefix(l - 1);
+    }
+
+    /**
+     * Updates the array values in the range
+     * [l, r] adding delta to them.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(const size_t l, const size_t r, const T delta)
+    {
+        assert(l <= r and r < arr_size);
+        b1.update(l, delta);
+        b2.update(l, delta * T(l));
+        if(r + 1 < arr_size) {
+            b1.update(r + 1, -delta);
+            b2.update(r + 1, -delta * T(r + 1));
+        }
+    }
+
+private:
+    Fenwick<T> b1, b2;
+    size_t arr_size;
+};
+
+/**
+ * Fenwick Tree 2D.
+ *
+ * Fenwick Tree over a matrix, which can
+ * replace SegTree2D<RSumQ, T> when only
+ * sums are needed. The tree is stored in
+ * a single flat vector.
+ *
+ * Time Complexity: O(n*m).
+ * Space Complexity: O(n*m).
+ * Where n is the height and m is the width of the matrix.
+ */
+template<typename T>
+class Fenwick2D
+{
+public:
+    Fenwick2D(const size_t mat_height = 1, const size_t mat_width = 1) :
+        tree((mat_height + 1) * (mat_width + 1), 0), mat_height(mat_height), mat_width(mat_width) {}
+
+    Fenwick2D(const vector<vector<T> > &mat) :
+        Fenwick2D(mat.size(), mat.empty() ? 0 : mat[0].size(), mat) {}
+
+    Fenwick2D(const size_t mat_height, const size_t mat_width, const vector<vector<T> > &mat) :
+        Fenwick2D(mat_height, mat_width)
+    {
+        assert(mat_height <= mat.size());
+        for(size_t i = 1; i <= mat_height; ++i) {
+            assert(mat_width <= mat[i - 1].size());
+            for(size_t j = 1; j <= mat_width; ++j)
+                at(i, j) += mat[i - 1][j - 1];
+        }
+
+        // propagates the values along the rows and then along the columns.
+        for(size_t i = 1; i <= mat_height; ++i) {
+            for(size_t j = 1; j <= mat_width; ++j) {
+                size_t k = j + (j & -j);
+                if(k <= mat_width)
+                    at(i, k) += at(i, j);
+            }
+        }
+        for(size_t i = 1; i <= mat_height; ++i) {
+            size_t k = i + (i & -i);
+            if(k <= mat_height) {
+                for(size_t j = 1; j <= mat_width; ++j)
+                    at(k, j) += at(i, j);
+            }
+        }
+    }
+
+    /**
+     * Computes the sum of the submatrix with
+     * rows [0, r1] and columns [0, r2].
+     *
+     * Time Complexity: O(log(n)*log(m)).
+     * Space Complexity: O(1).
+     * Where n is the height and m is the width of the matrix.
+     */
+    T prefix(const size_t r1, const size_t r2) const
+    {
+        assert(r1 < mat_height);
+        assert(r2 < mat_width);
+        T res = 0;
+        for(size_t i = r1 + 1; i > 0; i -= i & -i)
+            for(size_t j = r2 + 1; j > 0; j -= j & -j)
+                res += at(i, j);
+        return res;
+    }
+
+    /**
+     * Computes the matrix value in the ith
+     * row and jth column.
+     *
+     * Time Complexity: O(log(n)*log(m)).
+     * Space Complexity: O(1).
+     * Where n is the height and m is the width of the matrix.
+     */
+    T query(const size_t i, const size_t j) const
+    {
+        return query(i, i, j, j);
+    }
+
+    /**
+     * Computes the sum corresponding to the
+     * row range [l1, r1] and column range
+     * [l2, r2] of the matrix.
+     *
+     * Time Complexity: O(log(n)*log(m)).
+     * Space Complexity: O(1).
+     * Where n is the height and m is the width of the matrix.
+     */
+    T query(const size_t l1, const size_t r1, const size_t l2, const size_t r2) const
+    {
+        assert(l1 <= r1 and r1 < mat_height);
+        assert(l2 <= r2 and r2 < mat_width);
+        T res = prefix(r1, r2);
+        if(l1 > 0)
+            res -= prefix(l1 - 1, r2);
+        if(l2 > 0)
+            res -= prefix(r1, l2 - 1);
+        if(l1 > 0 and l2 > 0)
+            res += prefix(l1 - 1, l2 - 1);
+        return res;
+    }
+
+    /**
+     * Updates the the matrix value in the ith
+     * row and jth column adding delta to it.
+     *
+     * Time Complexity: O(log(n)*log(m)).
+     * Space Complexity: O(1).
+     * Where n is the height and m is the width of the matrix.
+     */
+    void update(const size_t i, const size_t j, const T delta)
+    {
+        assert(i < mat_height);
+        assert(j < mat_width);
+        for(size_t x = i + 1; x <= mat_height; x += x & -x)
+            for(size_t y = j + 1; y <= mat_width; y += y & -y)
+                at(x, y) += delta;
+    }
+
+private:
+    T &at(const size_t i, const size_t j)
+    {
+        return tree[i * (mat_width + 1) + j];
+    }
+
+    T at(const size_t i, const size_t j) const
+    {
+        return tree[i * (mat_width + 1) + j];
+    }
+
+    vector<T> tree;
+    size_t mat_height, mat_width;
+};
+
+/**
+ * Offline Fenwick Tree 2D.
+ *
+ * Fenwick Tree 2D over a set of points
+ * known beforehand (the only ones which
+ * can be updated), which can replace
+ * SegTree2D<RSumQ, T> and Fenwick2D when
+ * the grid is too big but sparse. Every
+ * node of the Fenwick Tree over the sorted
+ * x coordinates keeps a Fenwick Tree over
+ * the sorted y coordinates of its points,
+ * and all of them are stored in flat
+ * vectors.
+ *
+ * Time Complexity: O(p*log(p)^2).
+ * Space Complexity: O(p*log(p)).
+ * Where p is the number of points.
+ */
+template<typename T>
+class OfflineFenwick2D
+{
+public:
+    OfflineFenwick2D(const vector<pair<int, int> > &points)
+    {
+        xs.reserve(points.size());
+        for(const auto &p: points)
+            xs.push_back(p.first);
+        sort(xs.begin(), xs.end());
+        xs.erase(unique(xs.begin(), xs.end()), xs.end());
+
+        // collects the y coordinates of each node and flattens them.
+        vector<vector<int> > node_ys(xs.size() + 1);
+        for(const auto &p: points)
+            for(size_t i = x_rank(p.first) + 1; i <= xs.size(); i += i & -i)
+                node_ys[i].push_back(p.second);
+        offset.assign(xs.size() + 2, 0);
+        for(size_t i = 1; i <= xs.size(); ++i) {
+            sort(node_ys[i].begin(), node_ys[i].end());
+            node_ys[i].erase(unique(node_ys[i].begin(), node_ys[i].end()), node_ys[i].end());
+            offset[i + 1] = offset[i] + node_ys[i].size();
+        }
+        ys.reserve(offset.back());
+        for(size_t i = 1; i <= xs.size(); ++i)
+            ys.insert(ys.end(), node_ys[i].begin(), node_ys[i].end());
+        tree.assign(ys.size(), 0);
+    }
+
+    /**
+     * Computes the sum of the points (x', y')
+     * such that x' <= x and y' <= y.
+     *
+     * Time Complexity: O(log(p)^2).
+     * Space Complexity: O(1).
+     * Where p is the number of points.
+     */
+    T prefix(const int x, const int y) const
+    {
+        T res = 0;
+        for(size_t i = upper_bound(xs.begin(), xs.end(), x) - xs.begin(); i > 0; i -= i & -i) {
+            auto first = ys.begin() + offset[i], last = ys.begin() + offset[i + 1];
+            for(size_t j = upper_bound(first, last, y) - first; j > 0; j -= j & -j)
+                res += tree[offset[i] + j - 1];
+        }
+        return res;
+    }
+
+    /**
+     * Computes the sum of the points inside
+     * the rectangle [x1, x2]x[y1, y2].
+     *
+     * Time Complexity: O(log(p)^2).
+     * Space Complexity: O(1).
+     * Where p is the number of points.
+     */
+    T query(const int x1, const int x2, const int y1, const int y2) const
+    {
+        assert(x1 <= x2 and y1 <= y2);
+        return prefix(x2, y2) - prefix(x1 - 1, y2) - prefix(x2, y1 - 1) + prefix(x1 - 1, y1 - 1);
+    }
+
+    /**
+     * Updates the value of the point (x, y)
+     * adding delta to it.
+     *
+     * Note: (x, y) must be one of the points
+     * given to the constructor.
+     *
+     * Time Complexity: O(log(p)^2).
+     * Space Complexity: O(1).
+     * Where p is the number of points.
+     */
+    void update(const int x, const int y, const T delta)
+    {
+        for(size_t i = x_rank(x) + 1; i <= xs.size(); i += i & -i) {
+            auto first = ys.begin() + offset[i], last = ys.begin() + offset[i + 1];
+            auto it = lower_bound(first, last, y);
+            assert(it != last and *it == y);
+            size_t len = last - first;
+            for(size_t j = it - first + 1; j <= len; j += j & -j)
+                tree[offset[i] + j - 1] += delta;
+        }
+    }
+
+private:
+    size_t x_rank(const int x) const
+    {
+        auto it = lower_bound(xs.begin(), xs.end(), x);
+        assert(it != xs.end() and *it == x);
+        return it - xs.begin();
+    }
+
+    vector<int> xs, ys;
+    vector<size_t> offset;
+    vector<T> tree;
+};
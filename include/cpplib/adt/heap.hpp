@@ -6,3 +6,224 @@ using max_heap = priority_queue<T>;
 
 template<typename T>
 using min_heap = priority_queue<T, vector<T>, greater<T> >;
+
+/**
+ * Indexed Heap.
+ *
+ * Binary heap of the keys of the ids in
+ * [0, n), where each id is in the heap at
+ * most once, so changing its key moves it
+ * instead of adding a duplicate. The top is
+ * the id whose key comes first by Compare
+ * (the smallest one by default).
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the number of ids.
+ */
+template<typename T, typename Compare = less<T> >
+class IndexedHeap
+{
+public:
+    IndexedHeap(const size_t n, const Compare &cmp = Compare()) :
+        pos(n, none), cmp(cmp) {}
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    bool contains(const size_t id) const
+    {
+        assert(id < pos.size());
+        return pos[id] != none;
+    }
+
+    /**
+     * Returns the id on the top and its key.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    const pair<T, size_t> &top() const
+    {
+        assert(!empty());
+        return heap[0];
+    }
+
+    /**
+     * Inserts id with key, or changes the key
+     * of id if it's already in the heap.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the heap.
+     */
+    void push(const size_t id, const T &key)
+    {
+        assert(id < pos.size());
+        if(pos[id] == none) {
+            pos[id] = heap.size();
+            heap.emplace_back(key, id);
+            up(pos[id]);
+        }
+        else if(cmp(key, heap[pos[id]].first)) {
+            heap[pos[id]].first = key;
+            up(pos[id]);
+        }
+        else {
+            heap[pos[id]].first = key;
+            down(pos[id]);
+        }
+    }
+
+    /**
+     * Removes the top.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the heap.
+     */
+    void pop()
+    {
+        assert(!empty());
+        pos[heap[0].second] = none;
+        if(heap.size() > 1) {
+            heap[0] = heap.back();
+            pos[heap[0].second] = 0;
+        }
+        heap.pop_back();
+        if(!heap.empty())
+            down(0);
+    }
+
+private:
+    void up(size_t i)
+    {
+        pair<T, size_t> cur = heap[i];
+        for(; i > 0 and cmp(cur.first, heap[(i - 1) / 2].first); i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+            pos[heap[i].second] = i;
+        }
+        heap[i] = cur;
+        pos[cur.second] = i;
+    }
+
+    void down(size_t i)
+    {
+        pair<T, size_t> cur = heap[i];
+        for(size_t c; (c = 2 * i + 1) < heap.size(); i = c) {
+            if(c + 1 < heap.size() and cmp(heap[c + 1].first, heap[c].first))
+                c++;
+            if(!cmp(heap[c].first, cur.first))
+                break;
+            heap[i] = heap[c];
+            pos[heap[i].second] = i;
+        }
+        heap[i] = cur;
+        pos[cur.second] = i;
+    }
+
+    static constexpr size_t none = numeric_limits<size_t>::max();
+
+    vector<pair<T, size_t> > heap;
+    vector<size_t> pos;
+    Compare cmp;
+};
+
+/**
+ * Radix Heap.
+ *
+ * Monotone min heap of unsigned keys, i.e.
+ * no key pushed is smaller than the last
+ * one popped (as in Dijkstra). The pairs
+ * are kept in buckets by the highest bit in
+ * which their key differs from the last
+ * popped one, and every pair moves to a
+ * lower bucket at most once per bit.
+ *
+ * Time Complexity: O(log(C)) amortized per operation.
+ * Space Complexity: O(n).
+ * Where C is the largest key and n is the number of pairs in the heap.
+ */
+template<typename V>
+class RadixHeap
+{
+public:
+    bool empty() const
+    {
+        return cnt == 0;
+    }
+
+    size_t size() const
+    {
+        return cnt;
+    }
+
+    /**
+     * Inserts value with key, which must not
+     * be smaller than the last popped key.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void push(const uint64_t key, const V &value)
+    {
+        assert(key >= last);
+        buckets[bucket(key ^ last)].emplace_back(key, value);
+        cnt++;
+    }
+
+    /**
+     * Returns the pair with the smallest key.
+     *
+     * Time Complexity: O(log(C)) amortized.
+     * Space Complexity: O(1).
+     * Where C is the largest key.
+     */
+    const pair<uint64_t, V> &top()
+    {
+        assert(!empty());
+        if(buckets[0].empty()) {
+            size_t i = 1;
+            while(buckets[i].empty())
+                i++;
+            last = min_element(all(buckets[i]), [](const pair<uint64_t, V> &lhs, const pair<uint64_t, V> &rhs) {
+                       return lhs.first < rhs.first;
+                   })->first;
+            for(auto &p: buckets[i])
+                buckets[bucket(p.first ^ last)].emplace_back(p);
+            buckets[i].clear();
+        }
+        return buckets[0].back();
+    }
+
+    /**
+     * Removes the pair with the smallest key.
+     *
+     * Time Complexity: O(log(C)) amortized.
+     * Space Complexity: O(1).
+     * Where C is the largest key.
+     */
+    void pop()
+    {
+        top();
+        buckets[0].pop_back();
+        cnt--;
+    }
+
+private:
+    static size_t bucket(const uint64_t x)
+    {
+        return x == 0 ? 0 : 64 - __builtin_clzll(x);
+    }
+
+    vector<pair<uint64_t, V> > buckets[65];
+    uint64_t last = 0;
+    size_t cnt = 0;
+};
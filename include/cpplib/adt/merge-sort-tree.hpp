@@ -0,0 +1,95 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Merge Sort Tree.
+ *
+ * Keeps the steps of a bottom-up merge
+ * sort: the level d holds the array with
+ * every aligned block of size 2^d sorted,
+ * so any range is the union of O(log(n))
+ * sorted blocks. It is the simpler (and
+ * heavier) alternative to the Wavelet
+ * Matrix for counting and kth queries.
+ *
+ * Time Complexity: O(n*log(n)).
+ * Space Complexity: O(n*log(n)).
+ * Where n is the size of the array.
+ */
+template<typename T>
+class MergeSortTree
+{
+public:
+    MergeSortTree(const vector<T> &arr) :
+        levels(1, arr), arr_size(arr.size())
+    {
+        assert(arr_size > 0);
+        for(size_t len = 1; len < arr_size; len *= 2) {
+            const vector<T> &prev = levels.back();
+            vector<T> cur(arr_size);
+            for(size_t i = 0; i < arr_size; i += 2 * len) {
+                size_t mid = min(i + len, arr_size), end = min(i + 2 * len, arr_size);
+                merge(prev.begin() + i, prev.begin() + mid, prev.begin() + mid, prev.begin() + end, cur.begin() + i);
+            }
+            levels.push_back(move(cur));
+        }
+    }
+
+    /**
+     * Counts the values less than x in the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)^2).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t count_less(size_t l, size_t r, const T x) const
+    {
+        assert(l <= r and r < arr_size);
+        size_t res = 0;
+        r++;
+        // l and r are multiples of 2^d at the level d.
+        for(size_t d = 0; l < r; ++d) {
+            size_t len = size_t(1) << d;
+            const vector<T> &level = levels[d];
+            if(l >> d & 1) {
+                res += size_t(lower_bound(level.begin() + l, level.begin() + l + len, x) - (level.begin() + l));
+                l += len;
+            }
+            if(l < r and r >> d & 1) {
+                r -= len;
+                res += size_t(lower_bound(level.begin() + r, level.begin() + r + len, x) - (level.begin() + r));
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Finds the kth (0-indexed) smallest value
+     * in the range [l, r] of the array, by a
+     * binary search over the sorted values.
+     *
+     * Time Complexity: O(log(n)^3).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T kth(const size_t l, const size_t r, const size_t k) const
+    {
+        assert(l <= r and r < arr_size);
+        assert(k <= r - l);
+        const vector<T> &sorted = levels.back();
+        size_t lo = 0, hi = arr_size - 1;
+        while(lo < hi) {  // the largest value with at most k values less than it.
+            size_t mid = (lo + hi + 1) / 2;
+            if(count_less(l, r, sorted[mid]) <= k)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return sorted[lo];
+    }
+
+private:
+    vector<vector<T> > levels;
+    size_t arr_size;
+};
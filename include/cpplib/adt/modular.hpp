@@ -158,4 +158,145 @@ struct modular
     }
 };
 
+/**
+ * Montgomery Modular.
+ *
+ * Keeps the values in Montgomery form
+ * (a*2^32 mod M), so that * is computed
+ * with two multiplications and a shift
+ * instead of a division by M. Meant for hot
+ * loops full of products (e.g. lazies of
+ * linear transforms), the conversions from
+ * and to integers cost a product each.
+ *
+ * Note: M must be odd and less than
+ * pow(2, 31).
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(1).
+ */
+template<uint32_t M>
+struct montgomery
+{
+    static_assert(M % 2 == 1 and M < (uint32_t(1) << 31), "M must be odd and less than pow(2, 31).");
+
+    uint32_t value;  // a*2^32 mod M.
+
+    constexpr montgomery() :
+        value(0) {}
+
+    template<typename T>
+    constexpr montgomery(const T value) :
+        value(reduce(uint64_t(value >= 0 ? uint64_t(value) % M : M - 1 - (uint64_t(-(value + 1)) % M)) * r2)) {}
+
+    template<typename T>
+    explicit operator T() const
+    {
+        return reduce(value);
+    }
+
+    montgomery operator-() const
+    {
+        return raw(value == 0 ? 0 : M - value);
+    }
+
+    montgomery &operator+=(const montgomery &rhs)
+    {
+        value += rhs.value;
+        if(value >= M)
+            value -= M;
+        return *this;
+    }
+
+    montgomery &operator-=(const montgomery &rhs)
+    {
+        value += (value < rhs.value ? M : 0) - rhs.value;
+        return *this;
+    }
+
+    montgomery &operator*=(const montgomery &rhs)
+    {
+        value = reduce(uint64_t(value) * rhs.value);
+        return *this;
+    }
+
+    /**
+     * Modular Binary Exponentiation.
+     *
+     * Computes pow(b, e)%M.
+     *
+     * Time Complexity: O(log(e)).
+     * Space Complexity: O(1).
+     */
+    friend montgomery exp(montgomery b, uint e)
+    {
+        montgomery res = 1;
+        for(; e > 0; e >>= 1) {
+            if(e & 1)
+                res *= b;
+            b *= b;
+        }
+        return res;
+    }
+
+    friend montgomery operator+(montgomery lhs, const montgomery &rhs)
+    {
+        return lhs += rhs;
+    }
+
+    friend montgomery operator-(montgomery lhs, const montgomery &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    friend montgomery operator*(montgomery lhs, const montgomery &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    friend bool operator==(const montgomery &lhs, const montgomery &rhs)
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend bool operator!=(const montgomery &lhs, const montgomery &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend string to_string(const montgomery &a)
+    {
+        return to_string(reduce(a.value));
+    }
+
+    friend ostream &operator<<(ostream &lhs, const montgomery &rhs)
+    {
+        return lhs << to_string(rhs);
+    }
+
+private:
+    // -M^-1 mod 2^32 (Newton's iterations) and 2^64 mod M.
+    static constexpr uint32_t neg_inv = []() {
+        uint32_t inv = M;
+        for(int32_t i = 0; i < 5; ++i)
+            inv *= 2 - M * inv;
+        return -inv;
+    }();
+    static constexpr uint32_t r2 = uint32_t((uint64_t(-1) % M + 1) % M);
+
+    static montgomery raw(const uint32_t value)
+    {
+        montgomery res;
+        res.value = value;
+        return res;
+    }
+
+    // computes x*2^-32 mod M, where x < M*2^32.
+    static constexpr uint32_t reduce(const uint64_t x)
+    {
+        uint32_t res = uint32_t((x + uint64_t(uint32_t(x) * neg_inv) * M) >> 32);
+        return res >= M ? res - M : res;
+    }
+};
+
 using mint = modular<MOD>;
@@ -0,0 +1,7 @@
+#pragma once
+#include <cpplib/adt/persistent-segtreeb.hpp>
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+template<STKind K, typename T>
+using PersistentSegTree = PersistentSegTreeB<STNode<K, T>, T>;
@@ -0,0 +1,238 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Persistent Segment Tree Base.
+ *
+ * Segment Tree which keeps every version
+ * of the array: a point update copies only
+ * the O(log(n)) nodes on the path to the
+ * updated leaf and shares the rest with
+ * the previous version. The nodes live in
+ * a contiguous arena and refer to their
+ * children by 32 bits indices, so there is
+ * no allocation per node.
+ *
+ * Note: version 0 is the initial array and
+ * every update creates a new version, which
+ * is returned as its handle.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n + u*log(n)).
+ * Where n is the size of the array and u is the number of updates.
+ */
+template<typename Node, typename T>
+class PersistentSegTreeB
+{
+public:
+    using lazy_type = typename Node::lazy_type;
+
+    PersistentSegTreeB(const size_t arr_size = 1) :
+        PersistentSegTreeB(arr_size, vector<T>(arr_size, Node().value)) {}
+
+    PersistentSegTreeB(const vector<T> &arr) :
+        PersistentSegTreeB(arr.size(), arr) {}
+
+    PersistentSegTreeB(const size_t arr_size, const vector<T> &arr) :
+        arr_size(arr_size)
+    {
+        assert(arr_size > 0 and arr_size <= arr.size());
+        assert(2 * arr_size < size_t(numeric_limits<int32_t>::max()));
+        arena.reserve(2 * arr_size - 1);
+        roots.push_back(build(0, arr_size - 1, arr));
+    }
+
+    /**
+     * Reserves space in the arena for the
+     * given number of upcoming updates.
+     *
+     * Time Complexity: O(n + u*log(n)).
+     * Space Complexity: O(n + u*log(n)).
+     * Where n is the size of the array and u is the number of updates.
+     */
+    void reserve(const size_t updates)
+    {
+        size_t height = 1;
+        while((size_t(1) << (height - 1)) < arr_size)
+            height++;
+        arena.reserve(arena.size() + updates * height);
+    }
+
+    /**
+     * Returns the number of versions.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t versions() const
+    {
+        return roots.size();
+    }
+
+    /**
+     * Computes the ith array value in the
+     * given version.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t version, const size_t i) const
+    {
+        assert(version < roots.size());
+        assert(i < arr_size);
+        int32_t pos = roots[version];
+        for(size_t l = 0, r = arr_size - 1; l < r;) {
+            size_t mid = (l + r) / 2;
+            if(i <= mid)
+                pos = arena[pos].left, r = mid;
+            else
+                pos = arena[pos].right, l = mid + 1;
+        }
+        return arena[pos].value;
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array in the given
+     * version.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    T query(const size_t version, const size_t l, const size_t r) const
+    {
+        assert(version < roots.size());
+        assert(l <= r and r < arr_size);
+        return query(0, arr_size - 1, l, r, roots[version]).value;
+    }
+
+    /**
+     * Creates a new version from the given
+     * one by updating its ith array value
+     * according to the node implementation.
+     * It returns the new version.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    size_t update(const size_t version, const size_t i, const lazy_type delta)
+    {
+        assert(version < roots.size());
+        assert(i < arr_size);
+        assert(arena.size() + 64 < size_t(numeric_limits<int32_t>::max()));
+
+        // copies the path to the leaf and then merges it back.
+        int32_t path[64], depth = 0, pos = copy(roots[version]);
+        roots.push_back(pos);
+        for(size_t l = 0, r = arr_size - 1; l < r; ++depth) {
+            size_t mid = (l + r) / 2;
+            path[depth] = pos;
+            if(i <= mid) {
+                pos = arena[pos].left = copy(arena[pos].left);
+                r = mid;
+            }
+            else {
+                pos = arena[pos].right = copy(arena[pos].right);
+                l = mid + 1;
+            }
+        }
+
+        Node leaf(arena[pos].value);
+        leaf.update_lazy(delta);
+        leaf.update(1);
+        arena[pos].value = leaf.value;
+        while(depth--) {
+            Cell &cell = arena[path[depth]];
+            cell.value = Node(Node(arena[cell.left].value), Node(arena[cell.right].value)).value;
+        }
+        return roots.size() - 1;
+    }
+
+    /**
+     * Finds the first index i such that the
+     * sum of the range [0, i] of the difference
+     * between the versions hi and lo is greater
+     * than k, i.e. the kth (0-indexed) element
+     * between both versions when the array
+     * counts the elements.
+     *
+     * It returns the size of the array when
+     * there is no such index.
+     *
+     * Note: it expects the values to be non
+     * negative sums (i.e. RSumQ nodes).
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t kth(const size_t lo, const size_t hi, T k) const
+    {
+        assert(lo < roots.size() and hi < roots.size());
+        int32_t a = roots[lo], b = roots[hi];
+        if(arena[b].value - arena[a].value <= k)
+            return arr_size;
+
+        size_t l = 0, r = arr_size - 1;
+        while(l < r) {
+            size_t mid = (l + r) / 2;
+            T cnt = arena[arena[b].left].value - arena[arena[a].left].value;
+            if(k < cnt) {
+                a = arena[a].left, b = arena[b].left;
+                r = mid;
+            }
+            else {
+                k -= cnt;
+                a = arena[a].right, b = arena[b].right;
+                l = mid + 1;
+            }
+        }
+        return l;
+    }
+
+private:
+    struct Cell
+    {
+        T value;
+        int32_t left, right;
+    };
+
+    int32_t copy(const int32_t pos)
+    {
+        arena.push_back(arena[pos]);
+        return int32_t(arena.size() - 1);
+    }
+
+    int32_t build(const size_t l, const size_t r, const vector<T> &arr)
+    {
+        int32_t pos = int32_t(arena.size());
+        arena.push_back({Node(arr[l]).value, -1, -1});
+        if(l == r)
+            return pos;
+
+        size_t mid = (l + r) / 2;
+        int32_t left = build(l, mid, arr), right = build(mid + 1, r, arr);
+        arena[pos] = {Node(Node(arena[left].value), Node(arena[right].value)).value, left, right};
+        return pos;
+    }
+
+    Node query(const size_t l, const size_t r, const size_t i, const size_t j, const int32_t pos) const
+    {
+        if(l >= i and r <= j)
+            return Node(arena[pos].value);
+
+        size_t mid = (l + r) / 2;
+        if(j <= mid)  // left.
+            return query(l, mid, i, j, arena[pos].left);
+        else if(i >= mid + 1)  // right.
+            return query(mid + 1, r, i, j, arena[pos].right);
+        return Node(query(l, mid, i, j, arena[pos].left), query(mid + 1, r, i, j, arena[pos].right));
+    }
+
+    vector<Cell> arena;
+    vector<int32_t> roots;
+    size_t arr_size;
+};
@@ -1,25 +1,175 @@
 #pragma once
 #include <cpplib/stdinc.hpp>
 
-template<class T>
-struct RMQ
+template<typename T>
+struct RMQMin
 {
-    vector<vector<T> > jmp;
+    T operator()(const T &lhs, const T &rhs) const
+    {
+        return min(lhs, rhs);
+    }
+};
+
+template<typename T>
+struct RMQMax
+{
+    T operator()(const T &lhs, const T &rhs) const
+    {
+        return max(lhs, rhs);
+    }
+};
+
+/**
+ * Range Min Query Structure.
+ *
+ * Sparse table over an idempotent operation
+ * Op (e.g. min, max, gcd, and, or), so that
+ * a range is covered by two overlapping
+ * power of two ranges. All the levels are
+ * stored contiguously, one after the other.
+ *
+ * Time Complexity: O(n*log(n)).
+ * Space Complexity: O(n*log(n)).
+ * Where n is the size of the array.
+ */
+template<typename T, typename Op = RMQMin<T> >
+class RMQ
+{
+public:
+    RMQ(const vector<T> &arr, const Op &op = Op()) :
+        offset(1, 0), op(op), arr_size(arr.size())
+    {
+        assert(!arr.empty());
+        size_t total = arr.size();
+        for(size_t pw = 1; 2 * pw <= arr.size(); pw *= 2) {
+            offset.push_back(total);
+            total += arr.size() - 2 * pw + 1;
+        }
+
+        table.resize(total);
+        copy(arr.begin(), arr.end(), table.begin());
+        for(size_t k = 1, pw = 1; k < offset.size(); ++k, pw *= 2)
+            for(size_t j = 0; j < arr.size() - 2 * pw + 1; ++j)
+                table[offset[k] + j] = op(table[offset[k - 1] + j], table[offset[k - 1] + j + pw]);
+    }
+
+    /**
+     * Computes the operation over the range
+     * [a, b] of the array.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    T query(const size_t a, const size_t b) const
+    {
+        assert(a <= b and b < arr_size);
+        size_t dep = 63 - __builtin_clzll(b - a + 1);
+        return op(table[offset[dep] + a], table[offset[dep] + b + 1 - (size_t(1) << dep)]);
+    }
 
-    RMQ(const vector<T> &V) :
-        jmp(1, V)
+private:
+    vector<T> table;
+    vector<size_t> offset;
+    Op op;
+    size_t arr_size;
+};
+
+/**
+ * Linear Range Min Query Structure.
+ *
+ * Splits the array in blocks of 64 values.
+ * Every value keeps a bitmask with the
+ * positions of its block which are the
+ * minimum of the range from them up to the
+ * value (a monotonic stack), so a range
+ * inside a block is answered with a single
+ * count trailing zeros, and the whole
+ * blocks are answered by a sparse table
+ * over the block minima. It keeps a copy of
+ * the array and one word per value, i.e.
+ * about 2n words.
+ *
+ * Note: Compare selects the minimum
+ * (greater<T> for maximum queries), other
+ * idempotent operations need RMQ.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename T, typename Compare = less<T> >
+class LinearRMQ
+{
+public:
+    LinearRMQ(const vector<T> &arr, const Compare &cmp = Compare()) :
+        cells(arr.size()), blocks(block_minima(arr, cmp), Best{cmp}), best{cmp}
     {
-        for(int pw = 1, k = 1; pw * 2 <= V.size(); pw *= 2, ++k) {
-            jmp.emplace_back(V.size() - pw * 2 + 1);
-            rep(j, 0, jmp[k].size())
-                jmp[k][j] = min(jmp[k - 1][j], jmp[k - 1][j + pw]);
+        for(size_t start = 0; start < arr.size(); start += 64) {
+            uint64_t stack = 0;
+            for(size_t i = start; i < min(start + 64, arr.size()); ++i) {
+                // pops the positions which aren't smaller than arr[i].
+                while(stack and !cmp(arr[start + 63 - __builtin_clzll(stack)], arr[i]))
+                    stack ^= uint64_t(1) << (63 - __builtin_clzll(stack));
+                stack |= uint64_t(1) << (i - start);
+                cells[i] = {arr[i], stack};
+            }
         }
     }
 
-    T query(int a, int b)
+    /**
+     * Computes the minimum value in the range
+     * [a, b] of the array.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    T query(const size_t a, const size_t b) const
     {
-        assert(a <= b);
-        int dep = 31 - __builtin_clz(b - a);
-        return min(jmp[dep][a], jmp[dep][b + 1 - (1 << dep)]);
+        assert(a <= b and b < cells.size());
+        size_t l = a / 64, r = b / 64;
+        if(l == r)
+            return in_block(a, b);
+
+        T res = best(in_block(a, 64 * l + 63), in_block(64 * r, b));
+        if(l + 1 < r)
+            res = best(res, blocks.query(l + 1, r - 1));
+        return res;
     }
+
+private:
+    struct Best
+    {
+        Compare cmp;
+
+        T operator()(const T &lhs, const T &rhs) const
+        {
+            return cmp(rhs, lhs) ? rhs : lhs;
+        }
+    };
+
+    static vector<T> block_minima(const vector<T> &arr, const Compare &cmp)
+    {
+        assert(!arr.empty());
+        vector<T> res((arr.size() + 63) / 64);
+        for(size_t i = 0; i < arr.size(); ++i)
+            res[i / 64] = (i % 64 == 0 or cmp(arr[i], res[i / 64]) ? arr[i] : res[i / 64]);
+        return res;
+    }
+
+    // each value is next to its mask, so they share the cache line.
+    struct Cell
+    {
+        T value;
+        uint64_t mask;
+    };
+
+    // minimum in [i, j], which are in the same block.
+    const T &in_block(const size_t i, const size_t j) const
+    {
+        return cells[i - i % 64 + __builtin_ctzll(cells[j].mask >> (i % 64) << (i % 64))].value;
+    }
+
+    vector<Cell> cells;
+    RMQ<T, Best> blocks;
+    Best best;
 };
@@ -0,0 +1,281 @@
+#pragma once
+#include <cpplib/adt/segtreeb.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Segment Tree Beats Lazy.
+ *
+ * Represents the function
+ * f(x) = min(max(x + add, lo), hi), which
+ * is closed under composition, so that
+ * range add, chmin and chmax can share the
+ * same lazy.
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(1).
+ */
+template<typename T>
+struct STBeatsLazy
+{
+    static constexpr T lowest = numeric_limits<T>::lowest();
+    static constexpr T highest = numeric_limits<T>::max();
+
+    T add = 0, lo = lowest, hi = highest;
+
+    static STBeatsLazy make_add(const T value)
+    {
+        STBeatsLazy res;
+        res.add = value;
+        return res;
+    }
+
+    static STBeatsLazy make_chmin(const T value)
+    {
+        STBeatsLazy res;
+        res.hi = value;
+        return res;
+    }
+
+    static STBeatsLazy make_chmax(const T value)
+    {
+        STBeatsLazy res;
+        res.lo = value;
+        return res;
+    }
+
+    /**
+     * Composes delta after the current
+     * function, i.e. x -> delta(f(x)).
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    STBeatsLazy &operator+=(const STBeatsLazy &delta)
+    {
+        // clamp(clamp(y, lo + b, hi + b), lo', hi') = clamp(y, clamp(lo + b, lo', hi'), clamp(hi + b, lo', hi')).
+        T l = (lo == lowest ? lowest : lo + delta.add), h = (hi == highest ? highest : hi + delta.add);
+        add += delta.add;
+        lo = min(max(l, delta.lo), delta.hi);
+        hi = max(min(h, delta.hi), delta.lo);
+        return *this;
+    }
+
+    bool operator!=(const STBeatsLazy &rhs) const
+    {
+        return add != rhs.add or lo != rhs.lo or hi != rhs.hi;
+    }
+};
+
+/**
+ * Segment Tree Beats Node.
+ *
+ * Keeps the sum (value), the two largest
+ * and two smallest distinct values and the
+ * count of the largest/smallest ones, so
+ * that a chmin (chmax) can be applied to a
+ * whole node when it only changes its
+ * largest (smallest) values.
+ *
+ * Time Complexity: O(1).
+ * Space Complexity: O(1).
+ */
+template<typename T>
+struct STBeatsNode : STNodeB<STBeatsNode<T>, T, STBeatsLazy<T> >
+{
+    using super_type = STNodeB<STBeatsNode<T>, T, STBeatsLazy<T> >;
+    using lazy_type = STBeatsLazy<T>;
+
+    T max1 = lazy_type::lowest, max2 = lazy_type::lowest;
+    T min1 = lazy_type::highest, min2 = lazy_type::highest;
+    size_t max_cnt = 0, min_cnt = 0;
+
+    STBeatsNode() :
+        super_type(0) {}
+
+    STBeatsNode(const T value) :
+        super_type(value), max1(value), min1(value), max_cnt(1), min_cnt(1) {}
+
+    STBeatsNode(const STBeatsNode &lhs, const STBeatsNode &rhs) :
+        super_type(lhs.value + rhs.value)
+    {
+        assert(!lhs.has_lazy() and !rhs.has_lazy());
+        max1 = max(lhs.max1, rhs.max1);
+        max2 = max(lhs.max1 == max1 ? lhs.max2 : lhs.max1, rhs.max1 == max1 ? rhs.max2 : rhs.max1);
+        max_cnt = (lhs.max1 == max1 ? lhs.max_cnt : 0) + (rhs.max1 == max1 ? rhs.max_cnt : 0);
+        min1 = min(lhs.min1, rhs.min1);
+        min2 = min(lhs.min1 == min1 ? lhs.min2 : lhs.min1, rhs.min1 == min1 ? rhs.min2 : rhs.min1);
+        min_cnt = (lhs.min1 == min1 ? lhs.min_cnt : 0) + (rhs.min1 == min1 ? rhs.min_cnt : 0);
+    }
+
+    /**
+     * Checks if delta only changes the largest
+     * and the smallest values of the node
+     * (the tag condition).
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    bool can_update(const lazy_type delta) const
+    {
+        T lo2 = (min2 == lazy_type::highest ? min2 : min2 + delta.add);
+        T hi2 = (max2 == lazy_type::lowest ? max2 : max2 + delta.add);
+        return lo2 > delta.lo and hi2 < delta.hi;
+    }
+
+    /**
+     * Updates the current node applying the
+     * lazy function.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void update(const size_t range)
+    {
+        const lazy_type lazy = this->lazy;
+        this->lazy = lazy_type();
+        if(max_cnt == 0)  // empty node.
+            return;
+
+        this->value += T(range) * lazy.add;
+        max1 += lazy.add;
+        min1 += lazy.add;
+        if(max2 != lazy_type::lowest)
+            max2 += lazy.add;
+        if(min2 != lazy_type::highest)
+            min2 += lazy.add;
+        chmax(lazy.lo);
+        chmin(lazy.hi);
+    }
+
+    void update_lazy(const lazy_type delta)
+    {
+        this->lazy += delta;
+    }
+
+private:
+    void chmin(const T x)
+    {
+        if(max1 <= x)
+            return;
+        this->value -= (max1 - x) * T(max_cnt);
+        if(min1 == max1)  // a single distinct value.
+            min1 = x;
+        else if(min2 == max1)
+            min2 = x;
+        max1 = x;
+    }
+
+    void chmax(const T x)
+    {
+        if(min1 >= x)
+            return;
+        this->value += (x - min1) * T(min_cnt);
+        if(max1 == min1)  // a single distinct value.
+            max1 = x;
+        else if(max2 == min1)
+            max2 = x;
+        min1 = x;
+    }
+};
+
+/**
+ * Segment Tree Beats.
+ *
+ * Segment Tree with range chmin (a[i] =
+ * min(a[i], x)), range chmax (a[i] =
+ * max(a[i], x)) and range add updates, and
+ * range sum, min and max queries. An update
+ * goes down past the covered nodes which
+ * don't meet the tag condition, which is
+ * amortized.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename T>
+class SegTreeBeats : public SegTreeB<STBeatsNode<T>, T>
+{
+public:
+    SegTreeBeats() :
+        SegTreeBeats(1) {}
+
+    SegTreeBeats(const size_t arr_size) :
+        super_type(arr_size, vector<T>(arr_size, 0)) {}
+
+    SegTreeBeats(const vector<T> &arr) :
+        super_type(arr) {}
+
+    SegTreeBeats(const size_t arr_size, const vector<T> &arr) :
+        super_type(arr_size, arr) {}
+
+    /**
+     * Applies a[i] = min(a[i], x) to the range
+     * [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)^2) amortized.
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void chmin(const size_t l, const size_t r, const T x)
+    {
+        this->update(l, r, lazy_type::make_chmin(x));
+    }
+
+    /**
+     * Applies a[i] = max(a[i], x) to the range
+     * [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)^2) amortized.
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void chmax(const size_t l, const size_t r, const T x)
+    {
+        this->update(l, r, lazy_type::make_chmax(x));
+    }
+
+    /**
+     * Adds x to the range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)^2) amortized.
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    void add(const size_t l, const size_t r, const T x)
+    {
+        this->update(l, r, lazy_type::make_add(x));
+    }
+
+    /**
+     * Computes the maximum value in the range
+     * [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    T query_max(const size_t l, const size_t r)
+    {
+        assert(l <= r and r < this->arr_size);
+        return super_type::query(0, this->arr_size - 1, l, r, 0).max1;
+    }
+
+    /**
+     * Computes the minimum value in the range
+     * [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    T query_min(const size_t l, const size_t r)
+    {
+        assert(l <= r and r < this->arr_size);
+        return super_type::query(0, this->arr_size - 1, l, r, 0).min1;
+    }
+
+private:
+    using super_type = SegTreeB<STBeatsNode<T>, T>;
+    using lazy_type = STBeatsLazy<T>;
+};
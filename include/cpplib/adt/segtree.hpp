@@ -83,9 +83,11 @@ T merge_values(STKind k, const T lhs, const T rhs)
  * Space Complexity: O(1).
  */
 template<STKind K, typename T>
-struct STNode : STNodeB<T>
+struct STNode : STNodeB<STNode<K, T>, T>
 {
-    using super_type = STNodeB<T>;
+    using super_type = STNodeB<STNode<K, T>, T>;
+
+    static constexpr bool additive = (K == RSumQ);
 
     STNode() :
         super_type(neutral_value<T>(K)) {}
@@ -10,6 +10,14 @@
  * and point updates over a matrix
  * effectively.
  *
+ * Note: range (rectangle) updates keep a
+ * tag tree per row node, which holds the
+ * deltas applied to all of its rows and is
+ * never pushed down, so they only work for
+ * sum nodes (RSumQ). The tag trees are only
+ * allocated when a range update reaches
+ * their row node.
+ *
  * Note: when the tree is constructed by
  * inserting each value one by one using
  * update, the time complexity is actually
@@ -23,22 +31,28 @@ template<typename Node, typename T>
 class SegTree2DB
 {
 public:
+    using lazy_type = typename Node::lazy_type;
+
     SegTree2DB() :
         SegTree2DB(1, 1) {}
 
     SegTree2DB(const size_t mat_height, const size_t mat_width) :
-        tree(4 * mat_height, internal_type(mat_width)),
-        mat_height(mat_height), mat_width(mat_width) {}
+        tree(4 * mat_height), tags(4 * mat_height), has_tags(4 * mat_height),
+        mat_height(mat_height), mat_width(mat_width)
+    {
+        build(0, mat_height - 1, 0);
+    }
 
-    SegTree2DB(const vector<vector<T> > &mat) :
-        SegTree2DB(mat.size(), mat[0].size(), mat) {}
+    SegTree2DB(const vector<vector<T> > &mat, const size_t threads = 1) :
+        SegTree2DB(mat.size(), mat[0].size(), mat, threads) {}
 
-    SegTree2DB(const size_t mat_height, const size_t mat_width, const vector<vector<T> > &mat) :
-        SegTree2DB(mat_height, mat_width)
+    SegTree2DB(const size_t mat_height, const size_t mat_width, const vector<vector<T> > &mat, const size_t threads = 1) :
+        tree(4 * mat_height), tags(4 * mat_height), has_tags(4 * mat_height),
+        mat_height(mat_height), mat_width(mat_width)
     {
         for(const vector<T> &arr: mat)
             assert(mat_width <= arr.size());
-        build(0, mat_height - 1, 0, mat);
+        build(0, mat_height - 1, 0, mat, threads);
     }
 
     /**
@@ -81,23 +95,70 @@ public:
      * Space Complexity: O(log(n) + log(m)).
      * Where n is the height and m is the width of the matrix.
      */
-    void update(const size_t i, const size_t j, const T value)
+    void update(const size_t i, const size_t j, const lazy_type delta)
     {
         assert(i < mat_height);
         assert(j < mat_width);
-        update(0, mat_height - 1, i, 0, j, value);
+        update(0, mat_height - 1, i, 0, j, delta);
+    }
+
+    /**
+     * Updates the matrix values in the row
+     * range [l1, r1] and column range [l2, r2]
+     * adding delta to them.
+     *
+     * Note: it's only meant for sum nodes
+     * (RSumQ), others don't compile.
+     *
+     * Time Complexity: O(log(n)*log(m)).
+     * Space Complexity: O(m + log(n) + log(m)).
+     * Where n is the height and m is the width of the matrix.
+     */
+    void update(const size_t l1, const size_t r1, const size_t l2, const size_t r2, const lazy_type delta)
+    {
+        static_assert(Node::additive, "range updates need sum nodes.");
+        assert(l1 <= r1 and r1 < mat_height);
+        assert(l2 <= r2 and r2 < mat_width);
+        update(0, mat_height - 1, l1, r1, 0, l2, r2, delta);
     }
 
 private:
     using internal_type = SegTreeB<Node, T>;
 
-    internal_type build(const size_t l, const size_t r, const size_t pos, const vector<vector<T> > &mat)
+    // smallest number of cells which is worth splitting between threads.
+    static constexpr size_t parallel_grain = size_t(1) << 15;
+
+    // allocates the inner trees of the real row nodes only.
+    void build(const size_t l, const size_t r, const size_t pos)
     {
+        tree[pos] = internal_type(mat_width);
         if(l == r)
-            return tree[pos] = internal_type(mat_width, mat[l]);
+            return;
 
         size_t mid = (l + r) / 2;
-        return tree[pos] = internal_type(build(l, mid, 2 * pos + 1, mat), build(mid + 1, r, 2 * pos + 2, mat));
+        build(l, mid, 2 * pos + 1);
+        build(mid + 1, r, 2 * pos + 2);
+    }
+
+    // the row nodes are built in place and split between the threads.
+    void build(const size_t l, const size_t r, const size_t pos, const vector<vector<T> > &mat, const size_t threads)
+    {
+        if(l == r) {
+            tree[pos] = internal_type(mat_width, mat[l]);
+            return;
+        }
+
+        size_t mid = (l + r) / 2;
+        if(threads > 1 and (r - l + 1) * mat_width >= parallel_grain) {
+            thread left([&] { build(l, mid, 2 * pos + 1, mat, threads / 2); });
+            build(mid + 1, r, 2 * pos + 2, mat, threads - threads / 2);
+            left.join();
+        }
+        else {
+            build(l, mid, 2 * pos + 1, mat, 1);
+            build(mid + 1, r, 2 * pos + 2, mat, 1);
+        }
+        tree[pos] = internal_type(tree[2 * pos + 1], tree[2 * pos + 2]);
     }
 
     Node query(const size_t l, const size_t r, const size_t i1, const size_t i2, const size_t pos, const size_t j1, const size_t j2)
@@ -109,24 +170,56 @@ private:
             return tree[pos].query(j1, j2);
 
         size_t mid = (l + r) / 2;
-        return Node(query(l, mid, i1, i2, 2 * pos + 1, j1, j2), query(mid + 1, r, i1, i2, 2 * pos + 2, j1, j2));
+        Node res(query(l, mid, i1, i2, 2 * pos + 1, j1, j2), query(mid + 1, r, i1, i2, 2 * pos + 2, j1, j2));
+        if(has_tags[pos]) {  // the deltas applied to all the rows in [l, r].
+            size_t rows = min(r, i2) - max(l, i1) + 1;
+            res = Node(res, Node(T(rows) * tags[pos].query(j1, j2)));
+        }
+        return res;
     }
 
-    void update(const size_t l, const size_t r, const size_t i, const size_t pos, const size_t j, const T delta)
+    void update(const size_t l, const size_t r, const size_t i, const size_t pos, const size_t j, const lazy_type delta)
     {
         if(l > i or r < i)
             return;
 
-        tree[pos].update(j, delta);
-
-        if(l == i and r == i)
+        if(l == r) {
+            tree[pos].update(j, delta);
             return;
+        }
 
         size_t mid = (l + r) / 2;
         update(l, mid, i, 2 * pos + 1, j, delta);
         update(mid + 1, r, i, 2 * pos + 2, j, delta);
+        if(Node::additive)
+            tree[pos].update(j, delta);
+        else  // e.g. a min isn't shifted by delta, it's merged back from the rows.
+            tree[pos].assign({{j, Node(Node(tree[2 * pos + 1].query(j)), Node(tree[2 * pos + 2].query(j))).value}});
+    }
+
+    void update(const size_t l, const size_t r, const size_t i1, const size_t i2, const size_t pos, const size_t j1, const size_t j2, const lazy_type delta)
+    {
+        if(l > i2 or r < i1)
+            return;
+
+        size_t rows = min(r, i2) - max(l, i1) + 1;
+        tree[pos].update(j1, j2, lazy_type(rows) * delta);
+
+        if(l >= i1 and r <= i2) {
+            if(!has_tags[pos]) {
+                tags[pos] = internal_type(mat_width);
+                has_tags[pos] = true;
+            }
+            tags[pos].update(j1, j2, delta);
+            return;
+        }
+
+        size_t mid = (l + r) / 2;
+        update(l, mid, i1, i2, 2 * pos + 1, j1, j2, delta);
+        update(mid + 1, r, i1, i2, 2 * pos + 2, j1, j2, delta);
     }
 
-    vector<internal_type> tree;
+    vector<internal_type> tree, tags;
+    vector<bool> has_tags;
     size_t mat_height, mat_width;
 };
@@ -8,13 +8,30 @@
  * that only a small number of nodes are
  * visited per query.
  *
+ * Note: Node is the derived node type
+ * (e.g. struct MyNode : STNodeB<MyNode, T>)
+ * so that every call is resolved at compile
+ * time and the nodes don't carry any
+ * virtual table, i.e. they're trivially
+ * copyable whenever T and L are.
+ *
+ * Note: L is the type of the lazy (the
+ * delta of the updates).
+ *
  * Time Complexity: O(1).
  * Space Complexity: O(1).
  */
-template<typename T>
+template<typename Node, typename T, typename L = T>
 struct STNodeB
 {
-    T value, lazy = 0;
+    using lazy_type = L;
+
+    // whether the node value is the sum of the range and a lazy of the
+    // whole range adds itself to each of its elements (as in RSumQ).
+    static constexpr bool additive = false;
+
+    T value;
+    L lazy = L();
 
     STNodeB()
     {
@@ -27,7 +44,7 @@ struct STNodeB
         // meant to initialize a node with a defined value.
     }
 
-    STNodeB(const STNodeB &lhs, const STNodeB &rhs)
+    STNodeB(const Node &lhs, const Node &rhs)
     {
         // meant to create a node by merging lhs and rhs.
     }
@@ -40,7 +57,7 @@ struct STNodeB
      * Time Complexity: O(1).
      * Space Complexity: O(1).
      */
-    virtual bool match(const T value) const
+    bool match(const T value) const
     {
         return true;
     }
@@ -49,10 +66,12 @@ struct STNodeB
      * Updates the current node according to
      * the node implementation.
      *
+     * Note: it must be implemented by Node.
+     *
      * Time Complexity: O(1).
      * Space Complexity: O(1).
      */
-    virtual void update(const size_t range) = 0;
+    void update(const size_t range);
 
     /**
      * Updates the current node's lazy
@@ -62,11 +81,26 @@ struct STNodeB
      * Time Complexity: O(1).
      * Space Complexity: O(1).
      */
-    virtual void update_lazy(const T delta)
+    void update_lazy(const L delta)
     {
         lazy += delta;
     }
 
+    /**
+     * Checks if delta can be applied to the
+     * whole (up to date) node as a lazy,
+     * otherwise the update goes down to its
+     * children (e.g. the tag condition of
+     * Segment Tree Beats).
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    bool can_update(const L /* delta */) const
+    {
+        return true;
+    }
+
     /**
      * Checks if the current node has some
      * kind of lazy to apply.
@@ -74,9 +108,21 @@ struct STNodeB
      * Time Complexity: O(1).
      * Space Complexity: O(1).
      */
-    virtual bool has_lazy() const
+    bool has_lazy() const
+    {
+        return lazy != L();
+    }
+
+    /**
+     * Passes the current node's lazy down
+     * to a child node.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void push(Node &child) const
     {
-        return lazy != 0;
+        child.update_lazy(lazy);
     }
 };
 
@@ -101,19 +147,22 @@ template<typename Node, typename T>
 class SegTreeB
 {
 public:
+    using lazy_type = typename Node::lazy_type;
+
     SegTreeB() :
         SegTreeB(1) {}
 
     SegTreeB(const size_t arr_size) :
         tree(4 * arr_size), arr_size(arr_size) {}
 
-    SegTreeB(const vector<T> &arr) :
-        SegTreeB(arr.size(), arr) {}
+    SegTreeB(const vector<T> &arr, const size_t threads = 1) :
+        SegTreeB(arr.size(), arr, threads) {}
 
-    SegTreeB(const size_t arr_size, const vector<T> &arr) :
+    SegTreeB(const size_t arr_size, const vector<T> &arr, const size_t threads = 1) :
         SegTreeB(arr_size)
     {
-        build(0, arr_size - 1, 0, arr);
+        assert(arr_size <= arr.size());
+        build(0, arr_size - 1, 0, arr.begin(), threads);
     }
 
     SegTreeB(const SegTreeB &lhs, const SegTreeB &rhs) :
@@ -124,6 +173,49 @@ public:
             tree[i] = Node(lhs.tree[i], rhs.tree[i]);
     }
 
+    /**
+     * Rebuilds the tree from the range
+     * [first, last) of random access
+     * iterators, which becomes the new array.
+     * The subtrees are built by up to the
+     * given number of threads, each one
+     * writing a disjoint part of the tree.
+     *
+     * Time Complexity: O(n/t + t).
+     * Space Complexity: O(n + t*log(n)).
+     * Where n is the size of the array and t is the number of threads.
+     */
+    template<typename It>
+    void assign(const It first, const It last, const size_t threads = 1)
+    {
+        assert(first < last);
+        arr_size = size_t(last - first);
+        tree.assign(4 * arr_size, Node());
+        build(0, arr_size - 1, 0, first, threads);
+    }
+
+    /**
+     * Sets the array values at the given
+     * indices (a later assignment to the same
+     * index wins) and rebuilds in place only
+     * the paths to them, by up to the given
+     * number of threads.
+     *
+     * Time Complexity: O(min(n, k*log(n))/t + k*log(k)).
+     * Space Complexity: O(k + t*log(n)).
+     * Where n is the size of the array, k is the number of values and t is the number of threads.
+     */
+    void assign(vector<pair<size_t, T> > values, const size_t threads = 1)
+    {
+        if(values.empty())
+            return;
+        stable_sort(values.begin(), values.end(), [](const pair<size_t, T> &a, const pair<size_t, T> &b) {
+            return a.first < b.first;
+        });
+        assert(values.back().first < arr_size);
+        assign(0, arr_size - 1, 0, values.data(), values.data() + values.size(), threads);
+    }
+
     /**
      * Finds the index of the (leftmost? first
      * : last) element over the array that
@@ -162,6 +254,51 @@ public:
         return find(0, arr_size - 1, l, r, 0, value, leftmost);
     }
 
+    /**
+     * Finds the largest r in [l, n] such that
+     * pred(query(l, r - 1)) is true, where
+     * pred is a monotone predicate over the
+     * values (true for the neutral value) and
+     * an empty range folds to the neutral
+     * value.
+     *
+     * It works with any node (e.g. prefix
+     * sums) in a single descent.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    template<typename Pred>
+    size_t max_right(const size_t l, const Pred &pred)
+    {
+        assert(l <= arr_size);
+        if(l == arr_size)
+            return arr_size;
+        Node acc;
+        return max_right(0, arr_size - 1, l, 0, acc, pred);
+    }
+
+    /**
+     * Finds the smallest l in [0, r + 1] such
+     * that pred(query(l, r)) is true, where
+     * pred is a monotone predicate over the
+     * values (true for the neutral value) and
+     * an empty range folds to the neutral
+     * value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array.
+     */
+    template<typename Pred>
+    size_t min_left(const size_t r, const Pred &pred)
+    {
+        assert(r < arr_size);
+        Node acc;
+        return min_left(0, arr_size - 1, r, 0, acc, pred);
+    }
+
     /**
      * Computes the ith array value.
      *
@@ -197,7 +334,7 @@ public:
      * Space Complexity: O(log(n)).
      * Where n is the size of the array.
      */
-    void update(const size_t i, const T delta)
+    void update(const size_t i, const lazy_type delta)
     {
         assert(i < arr_size);
         update(i, i, delta);
@@ -211,20 +348,134 @@ public:
      * Space Complexity: O(log(n)).
      * Where n is the size of the array.
      */
-    void update(const size_t l, const size_t r, const T delta)
+    void update(const size_t l, const size_t r, const lazy_type delta)
     {
         assert(l <= r and r < arr_size);
         update(0, arr_size - 1, l, r, 0, delta);
     }
 
-private:
-    Node build(const size_t l, const size_t r, const size_t pos, const vector<T> &arr)
+    /**
+     * Computes the values corresponding to a
+     * batch of ranges [l, r] of the array,
+     * returned in input order. On trees which
+     * don't fit in cache, the ranges are
+     * walked in groups, one node per range at
+     * a time, so that the next nodes of the
+     * whole group are prefetched together and
+     * their memory latencies overlap.
+     *
+     * Time Complexity: O(q*log(n)).
+     * Space Complexity: O(q).
+     * Where n is the size of the array and q is the number of ranges.
+     */
+    vector<T> query_batch(const vector<pair<size_t, size_t> > &ranges)
     {
-        if(l == r)
-            return tree[pos] = Node(arr[l]);
+        vector<T> res(ranges.size());
+        if(tree.size() * sizeof(Node) < batch_min_bytes) {  // mostly cached, nothing to hide.
+            for(size_t k = 0; k < ranges.size(); ++k)
+                res[k] = query(ranges[k].first, ranges[k].second);
+            return res;
+        }
+
+        Walker walkers[batch_group];
+        for(size_t first = 0; first < ranges.size(); first += batch_group) {
+            size_t cnt = min(batch_group, ranges.size() - first), active = cnt;
+            for(size_t k = 0; k < cnt; ++k) {
+                const pair<size_t, size_t> &range = ranges[first + k];
+                assert(range.first <= range.second and range.second < arr_size);
+                walkers[k] = Walker(range.first, range.second, arr_size);
+            }
+
+            while(active > 0) {
+                active = 0;
+                for(size_t k = 0; k < cnt; ++k)
+                    if(walkers[k].mode != Walker::DONE) {
+                        step(walkers[k]);
+                        size_t child = 2 * walkers[k].pos + 1;
+                        if(walkers[k].mode != Walker::DONE and child < tree.size())
+                            __builtin_prefetch(tree.data() + child);
+                        active++;
+                    }
+            }
+            for(size_t k = 0; k < cnt; ++k)
+                res[first + k] = Node(walkers[k].acc_l, walkers[k].acc_r).value;
+        }
+        return res;
+    }
+
+    /**
+     * Updates the array values in a batch of
+     * ranges [l, r] according to the
+     * SegmentTreeKind, in input order.
+     *
+     * Note: the lazies don't commute in
+     * general (e.g. sets), so the updates
+     * can't be reordered nor grouped.
+     *
+     * Time Complexity: O(q*log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array and q is the number of ranges.
+     */
+    void update_batch(const vector<pair<size_t, size_t> > &ranges, const vector<lazy_type> &deltas)
+    {
+        assert(ranges.size() == deltas.size());
+        for(size_t k = 0; k < ranges.size(); ++k)
+            update(ranges[k].first, ranges[k].second, deltas[k]);
+    }
+
+protected:
+    // smallest range which is worth splitting between threads.
+    static constexpr size_t parallel_grain = size_t(1) << 15;
+
+    template<typename It>
+    void build(const size_t l, const size_t r, const size_t pos, const It first, const size_t threads)
+    {
+        if(l == r) {
+            tree[pos] = Node(T(first[l]));
+            return;
+        }
+
+        size_t mid = (l + r) / 2;
+        if(threads > 1 and r - l + 1 >= parallel_grain) {
+            thread left([&] { build(l, mid, 2 * pos + 1, first, threads / 2); });
+            build(mid + 1, r, 2 * pos + 2, first, threads - threads / 2);
+            left.join();
+        }
+        else {
+            build(l, mid, 2 * pos + 1, first, 1);
+            build(mid + 1, r, 2 * pos + 2, first, 1);
+        }
+        tree[pos] = Node(tree[2 * pos + 1], tree[2 * pos + 2]);
+    }
+
+    // [lo, hi) are the (sorted) values to set inside the range [l, r].
+    void assign(const size_t l, const size_t r, const size_t pos, const pair<size_t, T> *lo, const pair<size_t, T> *hi, const size_t threads)
+    {
+        propagate(l, r, pos);
+        if(l == r) {
+            tree[pos] = Node((hi - 1)->second);
+            return;
+        }
 
         size_t mid = (l + r) / 2;
-        return tree[pos] = Node(build(l, mid, 2 * pos + 1, arr), build(mid + 1, r, 2 * pos + 2, arr));
+        const pair<size_t, T> *split = partition_point(lo, hi, [mid](const pair<size_t, T> &p) {
+            return p.first <= mid;
+        });
+        if(threads > 1 and lo != split and split != hi and size_t(hi - lo) >= parallel_grain) {
+            thread left([&] { assign(l, mid, 2 * pos + 1, lo, split, threads / 2); });
+            assign(mid + 1, r, 2 * pos + 2, split, hi, threads - threads / 2);
+            left.join();
+        }
+        else {
+            if(lo != split)
+                assign(l, mid, 2 * pos + 1, lo, split, 1);
+            if(split != hi)
+                assign(mid + 1, r, 2 * pos + 2, split, hi, 1);
+        }
+        // the child nodes which weren't visited may still hold the lazy.
+        propagate(l, mid, 2 * pos + 1);
+        propagate(mid + 1, r, 2 * pos + 2);
+        tree[pos] = Node(tree[2 * pos + 1], tree[2 * pos + 2]);
     }
 
     size_t find(const size_t l, const size_t r, const size_t i, const size_t j, const size_t pos, const T value, const bool leftmost)
@@ -258,6 +509,127 @@ private:
         }
     }
 
+    // number of ranges walked together by query_batch, and the smallest
+    // tree (in bytes) for which walking them together pays off.
+    static constexpr size_t batch_group = 16;
+    static constexpr size_t batch_min_bytes = size_t(1) << 24;
+
+    // the state of a query going down the tree: first along the common
+    // path of its ends, and then along the left and the right borders.
+    struct Walker
+    {
+        enum Mode { COMMON, LEFT, RIGHT, DONE };
+
+        Mode mode = DONE;
+        size_t i, j, l, r, pos = 0;
+        size_t split_l, split_r, split_pos;  // the node where the borders split.
+        Node acc_l, acc_r;
+
+        Walker() {}
+
+        Walker(const size_t i, const size_t j, const size_t arr_size) :
+            mode(COMMON), i(i), j(j), l(0), r(arr_size - 1) {}
+    };
+
+    // moves the walker one level down, folding the covered nodes.
+    void step(Walker &w)
+    {
+        propagate(w.l, w.r, w.pos);
+        size_t mid = (w.l + w.r) / 2, left = 2 * w.pos + 1, right = 2 * w.pos + 2;
+        if(w.mode == Walker::COMMON) {
+            if(w.l >= w.i and w.r <= w.j) {
+                w.acc_l = tree[w.pos];
+                w.mode = Walker::DONE;
+            }
+            else if(w.j <= mid)  // left.
+                w.r = mid, w.pos = left;
+            else if(w.i >= mid + 1)  // right.
+                w.l = mid + 1, w.pos = right;
+            else {  // both.
+                w.split_l = mid + 1, w.split_r = w.r, w.split_pos = right;
+                w.mode = Walker::LEFT;
+                w.r = mid, w.pos = left;
+            }
+        }
+        else if(w.mode == Walker::LEFT) {  // the suffix [i, r] of the node.
+            if(w.l >= w.i) {
+                w.acc_l = Node(tree[w.pos], w.acc_l);
+                w.mode = Walker::RIGHT;
+                w.l = w.split_l, w.r = w.split_r, w.pos = w.split_pos;
+            }
+            else if(w.i <= mid) {
+                propagate(mid + 1, w.r, right);
+                w.acc_l = Node(tree[right], w.acc_l);
+                w.r = mid, w.pos = left;
+            }
+            else
+                w.l = mid + 1, w.pos = right;
+        }
+        else {  // the prefix [l, j] of the node.
+            if(w.r <= w.j) {
+                w.acc_r = Node(w.acc_r, tree[w.pos]);
+                w.mode = Walker::DONE;
+            }
+            else if(w.j >= mid + 1) {
+                propagate(w.l, mid, left);
+                w.acc_r = Node(w.acc_r, tree[left]);
+                w.l = mid + 1, w.pos = right;
+            }
+            else
+                w.r = mid, w.pos = left;
+        }
+    }
+
+    // acc is the fold of [i, l - 1] (the nodes visited so far).
+    template<typename Pred>
+    size_t max_right(const size_t l, const size_t r, const size_t i, const size_t pos, Node &acc, const Pred &pred)
+    {
+        if(r < i)
+            return arr_size;
+
+        propagate(l, r, pos);
+        if(l >= i) {
+            Node merged(acc, tree[pos]);
+            if(pred(merged.value)) {
+                acc = merged;
+                return arr_size;
+            }
+            if(l == r)
+                return l;
+        }
+
+        size_t mid = (l + r) / 2;
+        size_t res = max_right(l, mid, i, 2 * pos + 1, acc, pred);
+        if(res != arr_size)
+            return res;
+        return max_right(mid + 1, r, i, 2 * pos + 2, acc, pred);
+    }
+
+    // acc is the fold of [r + 1, j] (the nodes visited so far).
+    template<typename Pred>
+    size_t min_left(const size_t l, const size_t r, const size_t j, const size_t pos, Node &acc, const Pred &pred)
+    {
+        if(l > j)
+            return 0;
+
+        propagate(l, r, pos);
+        if(r <= j) {
+            Node merged(tree[pos], acc);
+            if(pred(merged.value)) {
+                acc = merged;
+                return 0;
+            }
+            if(l == r)
+                return l + 1;
+        }
+
+        size_t mid = (l + r) / 2;
+        size_t res = min_left(mid + 1, r, j, 2 * pos + 2, acc, pred);
+        if(res != 0)
+            return res;
+        return min_left(l, mid, j, 2 * pos + 1, acc, pred);
+    }
+
     Node query(const size_t l, const size_t r, const size_t i, const size_t j, const size_t pos)
     {
         propagate(l, r, pos);
@@ -274,12 +646,13 @@ private:
             return Node(query(l, mid, i, j, 2 * pos + 1), query(mid + 1, r, i, j, 2 * pos + 2));
     }
 
-    void update(const size_t l, const size_t r, const size_t i, const size_t j, const size_t pos, const T delta)
+    void update(const size_t l, const size_t r, const size_t i, const size_t j, const size_t pos, const lazy_type delta)
     {
         propagate(l, r, pos);
 
-        if(l >= i and r <= j) {
-            tree[pos].lazy = delta;
+        // a leaf always takes the lazy, whatever the tag condition says.
+        if(l >= i and r <= j and (l == r or tree[pos].can_update(delta))) {
+            tree[pos].update_lazy(delta);
             return;
         }
 
@@ -298,21 +671,18 @@ private:
         tree[pos] = Node(tree[2 * pos + 1], tree[2 * pos + 2]);
     }
 
-    virtual void propagate(const size_t l, const size_t r, const size_t pos)
+    void propagate(const size_t l, const size_t r, const size_t pos)
     {
         if(!tree[pos].has_lazy())
             return;
 
-        T lazy = tree[pos].lazy;
-        tree[pos].update(r - l + 1);
-
         if(l != r) {
-            tree[2 * pos + 1].update_lazy(lazy);
-            tree[2 * pos + 2].update_lazy(lazy);
+            tree[pos].push(tree[2 * pos + 1]);
+            tree[pos].push(tree[2 * pos + 2]);
         }
+        tree[pos].update(r - l + 1);
     }
 
-protected:
     vector<Node> tree;
     size_t arr_size;
 };
@@ -0,0 +1,10 @@
+#pragma once
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/adt/segtreeib.hpp>
+#include <cpplib/stdinc.hpp>
+
+template<STKind K, typename T>
+using SegTreeI = SegTreeIB<STNode<K, T>, T>;
+
+template<STKind K, typename T>
+using SegTreeIL = SegTreeILB<STNode<K, T>, T>;
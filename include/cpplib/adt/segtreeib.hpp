@@ -0,0 +1,442 @@
+#pragma once
+#include <cpplib/adt/segtreeb.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Iterative Segment Tree Base.
+ *
+ * Same as the Segment Tree Base but the
+ * tree is stored bottom-up in 2*n nodes
+ * (the leaves are at [n, 2*n[ and the
+ * children of pos are 2*pos and 2*pos+1)
+ * and every operation is performed by
+ * loops instead of recursive calls.
+ *
+ * Note: this implementation only supports
+ * point updates, see SegTreeILB for range
+ * updates.
+ *
+ * Note: the node merge must be associative
+ * only, the order of the values is kept.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename Node, typename T>
+class SegTreeIB
+{
+public:
+    using lazy_type = typename Node::lazy_type;
+
+    SegTreeIB() :
+        SegTreeIB(1) {}
+
+    SegTreeIB(const size_t arr_size) :
+        tree(2 * arr_size), arr_size(arr_size) {}
+
+    SegTreeIB(const vector<T> &arr) :
+        SegTreeIB(arr.size(), arr) {}
+
+    SegTreeIB(const size_t arr_size, const vector<T> &arr) :
+        SegTreeIB(arr_size)
+    {
+        for(size_t i = 0; i < arr_size; ++i)
+            tree[arr_size + i] = Node(arr[i]);
+        for(size_t pos = arr_size - 1; pos > 0; --pos)
+            tree[pos] = Node(tree[2 * pos], tree[2 * pos + 1]);
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element over the array that
+     * matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, const bool leftmost = true) const
+    {
+        return find(value, 0, arr_size - 1, leftmost);
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element in the range [l, r] of the
+     * array that matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value in the range [l, r].
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, size_t l, size_t r, const bool leftmost = true) const
+    {
+        assert(l <= r and r < arr_size);
+        // the nodes covering [l, r] in order are lhs[0..a[ and rhs]b..0].
+        size_t lhs[64], rhs[64], a = 0, b = 0;
+        for(l += arr_size, r += arr_size + 1; l < r; l /= 2, r /= 2) {
+            if(l & 1)
+                lhs[a++] = l++;
+            if(r & 1)
+                rhs[b++] = --r;
+        }
+        for(size_t k = 0; k < a + b; ++k) {
+            size_t i = (leftmost ? k : a + b - 1 - k);
+            size_t pos = (i < a ? lhs[i] : rhs[a + b - 1 - i]);
+            size_t res = descend(pos, value, leftmost);
+            if(res != arr_size)
+                return res;
+        }
+        return arr_size;
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    T query(const size_t i) const
+    {
+        assert(i < arr_size);
+        return tree[arr_size + i].value;
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(size_t l, size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        Node lhs, rhs;
+        for(l += arr_size, r += arr_size + 1; l < r; l /= 2, r /= 2) {
+            if(l & 1)
+                lhs = Node(lhs, tree[l++]);
+            if(r & 1)
+                rhs = Node(tree[--r], rhs);
+        }
+        return Node(lhs, rhs).value;
+    }
+
+    /**
+     * Updates the ith array value according to
+     * the SegmentTreeKind.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(const size_t i, const lazy_type delta)
+    {
+        assert(i < arr_size);
+        size_t pos = arr_size + i;
+        tree[pos].update_lazy(delta);
+        tree[pos].update(1);
+        for(pos /= 2; pos > 0; pos /= 2)
+            tree[pos] = Node(tree[2 * pos], tree[2 * pos + 1]);
+    }
+
+private:
+    size_t descend(size_t pos, const T value, const bool leftmost) const
+    {
+        if(!tree[pos].match(value))
+            return arr_size;
+
+        // depth first search over the matching nodes of the subtree of pos.
+        const size_t root = pos;
+        while(pos < arr_size) {
+            size_t first = (leftmost ? 2 * pos : 2 * pos + 1);
+            if(tree[first].match(value))
+                pos = first;
+            else if(tree[first ^ 1].match(value))
+                pos = first ^ 1;
+            else {
+                // go back to the closest unvisited matching sibling.
+                while(pos != root and (pos % 2 != first % 2 or !tree[pos ^ 1].match(value)))
+                    pos /= 2;
+                if(pos == root)
+                    return arr_size;
+                pos ^= 1;
+            }
+        }
+        return pos - arr_size;
+    }
+
+    vector<Node> tree;
+    size_t arr_size;
+};
+
+/**
+ * Iterative Lazy Segment Tree Base.
+ *
+ * Same as the Iterative Segment Tree Base
+ * but with range updates, so the number of
+ * leaves is rounded up to a power of two
+ * and the lazies of the nodes on the paths
+ * to l and r are pushed down before each
+ * operation.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename Node, typename T>
+class SegTreeILB
+{
+public:
+    using lazy_type = typename Node::lazy_type;
+
+    SegTreeILB() :
+        SegTreeILB(1) {}
+
+    SegTreeILB(const size_t arr_size) :
+        arr_size(arr_size)
+    {
+        while((size_t(1) << height) < arr_size)
+            height++;
+        tree_size = size_t(1) << height;
+        tree.resize(2 * tree_size);
+    }
+
+    SegTreeILB(const vector<T> &arr) :
+        SegTreeILB(arr.size(), arr) {}
+
+    SegTreeILB(const size_t arr_size, const vector<T> &arr) :
+        SegTreeILB(arr_size)
+    {
+        for(size_t i = 0; i < arr_size; ++i)
+            tree[tree_size + i] = Node(arr[i]);
+        for(size_t pos = tree_size - 1; pos > 0; --pos)
+            tree[pos] = Node(tree[2 * pos], tree[2 * pos + 1]);
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element over the array that
+     * matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, const bool leftmost = true)
+    {
+        return find(value, 0, arr_size - 1, leftmost);
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element in the range [l, r] of the
+     * array that matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value in the range [l, r].
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, size_t l, size_t r, const bool leftmost = true)
+    {
+        assert(l <= r and r < arr_size);
+        l += tree_size;
+        r += tree_size + 1;
+        push(l);
+        push(r - 1);
+
+        // the nodes covering [l, r] in order are lhs[0..a[ and rhs]b..0].
+        size_t lhs[64], rhs[64], a = 0, b = 0;
+        for(size_t len = 1; l < r; l /= 2, r /= 2, len *= 2) {
+            if(l & 1) {
+                propagate(l, len);
+                lhs[a++] = l++;
+            }
+            if(r & 1) {
+                propagate(--r, len);
+                rhs[b++] = r;
+            }
+        }
+        for(size_t k = 0; k < a + b; ++k) {
+            size_t i = (leftmost ? k : a + b - 1 - k);
+            size_t pos = (i < a ? lhs[i] : rhs[a + b - 1 - i]);
+            size_t res = descend(pos, value, leftmost);
+            if(res != arr_size)
+                return res;
+        }
+        return arr_size;
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t i)
+    {
+        assert(i < arr_size);
+        return query(i, i);
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(size_t l, size_t r)
+    {
+        assert(l <= r and r < arr_size);
+        l += tree_size;
+        r += tree_size + 1;
+        push(l);
+        push(r - 1);
+
+        Node lhs, rhs;
+        for(size_t len = 1; l < r; l /= 2, r /= 2, len *= 2) {
+            if(l & 1) {
+                propagate(l, len);
+                lhs = Node(lhs, tree[l++]);
+            }
+            if(r & 1) {
+                propagate(--r, len);
+                rhs = Node(tree[r], rhs);
+            }
+        }
+        return Node(lhs, rhs).value;
+    }
+
+    /**
+     * Updates the ith array value according to
+     * the SegmentTreeKind.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(const size_t i, const lazy_type delta)
+    {
+        assert(i < arr_size);
+        update(i, i, delta);
+    }
+
+    /**
+     * Updates the array values in the range
+     * [l, r] according to the SegmentTreeKind.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(size_t l, size_t r, const lazy_type delta)
+    {
+        assert(l <= r and r < arr_size);
+        l += tree_size;
+        r += tree_size + 1;
+        const size_t l0 = l, r0 = r - 1;
+        push(l0);
+        push(r0);
+
+        for(; l < r; l /= 2, r /= 2) {
+            if(l & 1)
+                tree[l++].update_lazy(delta);
+            if(r & 1)
+                tree[--r].update_lazy(delta);
+        }
+        pull(l0);
+        pull(r0);
+    }
+
+private:
+    // applies the lazy of pos (whose range has size len).
+    void propagate(const size_t pos, const size_t len)
+    {
+        if(!tree[pos].has_lazy())
+            return;
+
+        if(pos < tree_size) {
+            tree[pos].push(tree[2 * pos]);
+            tree[pos].push(tree[2 * pos + 1]);
+        }
+        tree[pos].update(len);
+    }
+
+    // propagates every ancestor of the leaf pos from the root.
+    void push(const size_t pos)
+    {
+        for(size_t s = height; s > 0; --s)
+            propagate(pos >> s, size_t(1) << s);
+    }
+
+    // merges every ancestor of the leaf pos from the bottom.
+    void pull(size_t pos)
+    {
+        // it's important to propagate before merging the child nodes.
+        for(size_t len = 1; pos > 1; len *= 2) {
+            pos /= 2;
+            if(tree[pos].has_lazy())  // it was fully updated, so it's merged when propagated.
+                continue;
+            propagate(2 * pos, len);
+            propagate(2 * pos + 1, len);
+            tree[pos] = Node(tree[2 * pos], tree[2 * pos + 1]);
+        }
+    }
+
+    size_t descend(size_t pos, const T value, const bool leftmost)
+    {
+        if(!tree[pos].match(value))
+            return arr_size;
+
+        // depth first search over the matching nodes of the subtree of pos.
+        const size_t root = pos;
+        size_t len = size_t(1) << (height - (63 - __builtin_clzll(pos)));
+        while(pos < tree_size) {
+            len /= 2;
+            propagate(2 * pos, len);
+            propagate(2 * pos + 1, len);
+
+            size_t first = (leftmost ? 2 * pos : 2 * pos + 1);
+            if(tree[first].match(value))
+                pos = first;
+            else if(tree[first ^ 1].match(value))
+                pos = first ^ 1;
+            else {
+                // go back to the closest unvisited matching sibling.
+                len *= 2;
+                while(pos != root and (pos % 2 != first % 2 or !tree[pos ^ 1].match(value))) {
+                    pos /= 2;
+                    len *= 2;
+                }
+                if(pos == root)
+                    return arr_size;
+                pos ^= 1;
+            }
+        }
+        return pos - tree_size;
+    }
+
+    vector<Node> tree;
+    size_t arr_size, tree_size, height = 0;
+};
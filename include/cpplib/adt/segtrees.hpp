@@ -13,9 +13,9 @@
  * Space Complexity: O(1).
  */
 template<STKind K, typename T>
-struct STNodeS : STNodeSB<T>
+struct STNodeS : STNodeSB<STNodeS<K, T>, T>
 {
-    using super_type = STNodeSB<T>;
+    using super_type = STNodeSB<STNodeS<K, T>, T>;
 
     STNodeS() :
         super_type(neutral_value<T>(K)) {}
@@ -27,7 +27,7 @@ struct STNodeS : STNodeSB<T>
         super_type(merge_values<T>(K, lhs.value, rhs.value))
     {
         assert(lhs.lazy == 0 and rhs.lazy == 0);
-        assert(!lhs.set.second and !rhs.set.second);
+        assert(!lhs.has_set and !rhs.has_set);
     }
 
     /**
@@ -63,17 +63,17 @@ struct STNodeS : STNodeSB<T>
      */
     void update(const size_t range)
     {
-        if(this->set.second) {
+        if(this->has_set) {
             switch(K) {
                 case RMaxQ:
                 case RMinQ:
-                    this->value = this->set.first;
+                    this->value = this->set;
                     break;
                 case RSumQ:
-                    this->value = range * this->set.first;
+                    this->value = range * this->set;
                     break;
                 case RXorQ:
-                    this->value = (range % 2) * this->set.first;
+                    this->value = (range % 2) * this->set;
                     break;
                 default:
                     assert(false);
@@ -95,7 +95,7 @@ struct STNodeS : STNodeSB<T>
         }
 
         this->lazy = 0;
-        this->set = {0, false};
+        this->has_set = false;
     }
 };
 
@@ -12,11 +12,13 @@
  * Time Complexity: O(1).
  * Space Complexity: O(1).
  */
-template<typename T>
-struct STNodeSB : STNodeB<T>
+template<typename NodeS, typename T>
+struct STNodeSB : STNodeB<NodeS, T>
 {
-    using super_type = STNodeB<T>;
-    pair<T, bool> set = {0, false};
+    using super_type = STNodeB<NodeS, T>;
+
+    T set = 0;
+    bool has_set = false;
 
     STNodeSB() :
         super_type() {}
@@ -24,15 +26,55 @@ struct STNodeSB : STNodeB<T>
     STNodeSB(const T value) :
         super_type(value) {}
 
-    STNodeSB(const STNodeSB &lhs, const STNodeSB &rhs)
+    STNodeSB(const NodeS &lhs, const NodeS &rhs)
     {
         // meant to create a node by merging lhs and rhs.
     }
 
-    virtual void reset_lazy()
+    void reset_lazy()
     {
         this->lazy = 0;
     }
+
+    /**
+     * Sets the current node's values to
+     * value, discarding the previous lazy.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void update_set(const T value)
+    {
+        static_cast<NodeS &>(*this).reset_lazy();
+        set = value;
+        has_set = true;
+    }
+
+    /**
+     * Checks if the current node has some
+     * kind of lazy (or set) to apply.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    bool has_lazy() const
+    {
+        return super_type::has_lazy() or has_set;
+    }
+
+    /**
+     * Passes the current node's set and lazy
+     * down to a child node.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void push(NodeS &child) const
+    {
+        if(has_set)
+            child.update_set(set);
+        child.update_lazy(this->lazy);
+    }
 };
 
 /**
@@ -99,15 +141,31 @@ public:
         set(0, this->arr_size - 1, l, r, 0, value);
     }
 
+    /**
+     * Sets the array values in a batch of
+     * ranges [l, r] to the given values, in
+     * input order.
+     *
+     * Time Complexity: O(q*log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the array and q is the number of ranges.
+     */
+    void set_batch(const vector<pair<size_t, size_t> > &ranges, const vector<T> &values)
+    {
+        assert(ranges.size() == values.size());
+        for(size_t k = 0; k < ranges.size(); ++k)
+            set(ranges[k].first, ranges[k].second, values[k]);
+    }
+
 private:
     using super_type = SegTreeB<NodeS, T>;
 
     void set(const size_t l, const size_t r, const size_t i, const size_t j, const size_t pos, const T value)
     {
-        propagate(l, r, pos);
+        this->propagate(l, r, pos);
 
         if(l >= i and r <= j) {
-            this->tree[pos].set = {value, true};
+            this->tree[pos].update_set(value);
             return;
         }
 
@@ -121,30 +179,8 @@ private:
             set(mid + 1, r, i, j, 2 * pos + 2, value);
         }
         // it's important to propagate before merging the child nodes.
-        propagate(l, mid, 2 * pos + 1);
-        propagate(mid + 1, r, 2 * pos + 2);
+        this->propagate(l, mid, 2 * pos + 1);
+        this->propagate(mid + 1, r, 2 * pos + 2);
         this->tree[pos] = NodeS(this->tree[2 * pos + 1], this->tree[2 * pos + 2]);
     }
-
-    void propagate(const size_t l, const size_t r, const size_t pos)
-    {
-        if(!this->tree[pos].has_lazy() and !this->tree[pos].set.second)
-            return;
-
-        T lazy = this->tree[pos].lazy;
-        pair<T, bool> set = this->tree[pos].set;
-        this->tree[pos].update(r - l + 1);
-
-        if(l != r) {
-            if(set.second) {
-                this->tree[2 * pos + 1].set = set;
-                this->tree[2 * pos + 2].set = set;
-
-                this->tree[2 * pos + 1].reset_lazy();
-                this->tree[2 * pos + 2].reset_lazy();
-            }
-            this->tree[2 * pos + 1].update_lazy(lazy);
-            this->tree[2 * pos + 2].update_lazy(lazy);
-        }
-    }
 };
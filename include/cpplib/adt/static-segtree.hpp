@@ -0,0 +1,7 @@
+#pragma once
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/adt/static-segtreeb.hpp>
+#include <cpplib/stdinc.hpp>
+
+template<STKind K, typename T>
+using StaticSegTree = StaticSegTreeB<STNode<K, T>, T>;
@@ -0,0 +1,224 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Static Segment Tree Base.
+ *
+ * Build once Segment Tree for read-heavy
+ * workloads. The array is split into
+ * blocks of 64 bytes (one cache line) and
+ * only the block values are arranged in a
+ * bottom-up binary tree in Eytzinger (BFS)
+ * order, which is B times smaller than the
+ * usual tree (B is the number of values per
+ * block) so most of it stays in cache.
+ * A query merges the values of at most two
+ * partial blocks, which are prefetched
+ * before traversing the tree, with the
+ * nodes covering the blocks in between.
+ *
+ * Note: the nodes are only used to merge
+ * values, so only the values are stored.
+ *
+ * Note: for idempotent kinds (min, max) a
+ * sparse table (RMQ) answers faster, in
+ * O(1), but takes O(n*log(n)) memory, so
+ * this one is meant for the arrays where
+ * that doesn't fit or other kinds.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<typename Node, typename T>
+class StaticSegTreeB
+{
+public:
+    StaticSegTreeB(const vector<T> &arr) :
+        StaticSegTreeB(arr.size(), arr) {}
+
+    StaticSegTreeB(const size_t arr_size, const vector<T> &arr) :
+        blocks((arr_size + block_size - 1) / block_size), tree(2 * blocks.size()), arr_size(arr_size)
+    {
+        assert(arr_size > 0 and arr_size <= arr.size());
+        size_t n = blocks.size();
+        for(size_t b = 0; b < n; ++b) {
+            Node acc;
+            for(size_t k = 0, i = b * block_size; k < block_size; ++k, ++i) {
+                blocks[b].slot[k] = (i < arr_size ? Node(arr[i]) : Node()).value;
+                acc = Node(acc, Node(blocks[b].slot[k]));
+            }
+            tree[n + b] = acc.value;
+        }
+        for(size_t pos = n - 1; pos > 0; --pos)
+            tree[pos] = Node(Node(tree[2 * pos]), Node(tree[2 * pos + 1])).value;
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element over the array that
+     * matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, const bool leftmost = true) const
+    {
+        return find(value, 0, arr_size - 1, leftmost);
+    }
+
+    /**
+     * Finds the index of the (leftmost? first
+     * : last) element in the range [l, r] of the
+     * array that matches with value.
+     *
+     * It returns the size of the array when
+     * the value doesn't match with any array
+     * value in the range [l, r].
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    size_t find(const T value, const size_t l, const size_t r, const bool leftmost = true) const
+    {
+        assert(l <= r and r < arr_size);
+        size_t bl = l / block_size, br = r / block_size;
+        if(bl == br)
+            return leftmost ? scan(value, l, r, true) : scan(value, r, l, false);
+
+        // the partial blocks are scanned before and after the whole ones.
+        size_t res = leftmost ? scan(value, l, (bl + 1) * block_size - 1, true) : scan(value, r, br * block_size, false);
+        if(res != arr_size)
+            return res;
+
+        // the nodes covering the blocks in ]bl, br[ in order are lhs[0..a[ and rhs]b..0].
+        size_t n = blocks.size(), lhs[64], rhs[64], a = 0, b = 0;
+        for(size_t i = bl + 1 + n, j = br + n; i < j; i /= 2, j /= 2) {
+            if(i & 1)
+                lhs[a++] = i++;
+            if(j & 1)
+                rhs[b++] = --j;
+        }
+        for(size_t k = 0; k < a + b; ++k) {
+            size_t i = (leftmost ? k : a + b - 1 - k);
+            res = descend(value, (i < a ? lhs[i] : rhs[a + b - 1 - i]), leftmost);
+            if(res != arr_size)
+                return res;
+        }
+        return leftmost ? scan(value, br * block_size, r, true) : scan(value, (bl + 1) * block_size - 1, l, false);
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    T query(const size_t i) const
+    {
+        assert(i < arr_size);
+        return blocks[i / block_size].slot[i % block_size];
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(const size_t l, const size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        size_t bl = l / block_size, br = r / block_size;
+        __builtin_prefetch(&blocks[bl]);
+        __builtin_prefetch(&blocks[br]);
+
+        Node lhs, rhs;
+        if(bl == br) {
+            for(size_t k = l % block_size; k <= r % block_size; ++k)
+                lhs = Node(lhs, Node(blocks[bl].slot[k]));
+            return lhs.value;
+        }
+
+        Node mid_lhs, mid_rhs;
+        size_t n = blocks.size();
+        for(size_t i = bl + 1 + n, j = br + n; i < j; i /= 2, j /= 2) {
+            if(i & 1)
+                mid_lhs = Node(mid_lhs, Node(tree[i++]));
+            if(j & 1)
+                mid_rhs = Node(Node(tree[--j]), mid_rhs);
+        }
+        for(size_t k = l % block_size; k < block_size; ++k)
+            lhs = Node(lhs, Node(blocks[bl].slot[k]));
+        for(size_t k = 0; k <= r % block_size; ++k)
+            rhs = Node(rhs, Node(blocks[br].slot[k]));
+        return Node(Node(lhs, Node(mid_lhs, mid_rhs)), rhs).value;
+    }
+
+private:
+    static constexpr size_t block_size = (sizeof(T) < 64 ? 64 / sizeof(T) : 1);
+
+    struct alignas(64) Block
+    {
+        T slot[block_size];
+    };
+
+    // finds the first matching index from i to j (forward? up : down).
+    size_t scan(const T value, size_t i, const size_t j, const bool forward) const
+    {
+        while(true) {
+            if(Node(blocks[i / block_size].slot[i % block_size]).match(value))
+                return i;
+            if(i == j)
+                return arr_size;
+            forward ? ++i : --i;
+        }
+    }
+
+    size_t descend(const T value, size_t pos, const bool leftmost) const
+    {
+        // depth first search over the matching nodes of the subtree of pos,
+        // the matching blocks are scanned instead of going down.
+        const size_t root = pos, n = blocks.size();
+        bool down = Node(tree[pos]).match(value);
+        while(true) {
+            if(down and pos >= n) {
+                size_t lo = (pos - n) * block_size, hi = min(lo + block_size, arr_size) - 1;
+                size_t res = leftmost ? scan(value, lo, hi, true) : scan(value, hi, lo, false);
+                if(res != arr_size)
+                    return res;
+                down = false;
+            }
+            if(down) {
+                size_t first = (leftmost ? 2 * pos : 2 * pos + 1);
+                if(Node(tree[first]).match(value))
+                    pos = first;
+                else if(Node(tree[first ^ 1]).match(value))
+                    pos = first ^ 1;
+                else
+                    down = false;
+            }
+            if(!down) {
+                // go back to the closest unvisited matching sibling.
+                while(pos != root and (pos % 2 != !leftmost or !Node(tree[pos ^ 1]).match(value)))
+                    pos /= 2;
+                if(pos == root)
+                    return arr_size;
+                pos ^= 1;
+                down = true;
+            }
+        }
+    }
+
+    vector<Block> blocks;
+    vector<T> tree;
+    size_t arr_size;
+};
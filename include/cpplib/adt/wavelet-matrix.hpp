@@ -0,0 +1,280 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Bit Vector.
+ *
+ * Static sequence of bits which answers how
+ * many ones there are before a position
+ * (rank). Every 64 bytes block (one cache
+ * line) holds 6 words of bits, the number
+ * of ones before the block and before each
+ * of its words, so a rank touches a single
+ * cache line with a single popcount, and
+ * the extra space is 1/3 of the bits.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the number of bits.
+ */
+class BitVector
+{
+public:
+    BitVector(const size_t size = 0) :
+        blocks(size / block_bits + 1), bits(size) {}
+
+    size_t size() const
+    {
+        return bits;
+    }
+
+    /**
+     * Sets the ith bit, which is only allowed
+     * before calling build.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void set(const size_t i)
+    {
+        assert(i < bits);
+        blocks[i / block_bits].words[i % block_bits / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    /**
+     * Computes the number of ones before
+     * every block, after which the bits can't
+     * be changed.
+     *
+     * Time Complexity: O(n).
+     * Space Complexity: O(1).
+     * Where n is the number of bits.
+     */
+    void build()
+    {
+        uint64_t ones = 0;
+        for(Block &block: blocks) {
+            block.rank = ones;
+            block.sub = 0;
+            for(size_t w = 0; w < words_per_block; ++w) {
+                block.sub |= (ones - block.rank) << (9 * w);
+                ones += __builtin_popcountll(block.words[w]);
+            }
+        }
+    }
+
+    /**
+     * Returns the ith bit.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    bool operator[](const size_t i) const
+    {
+        assert(i < bits);
+        return blocks[i / block_bits].words[i % block_bits / 64] >> (i % 64) & 1;
+    }
+
+    /**
+     * Computes the number of ones in the range
+     * [0, i) of the bits.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t rank1(const size_t i) const
+    {
+        assert(i <= bits);
+        const Block &block = blocks[i / block_bits];
+        size_t offset = i % block_bits, w = offset / 64;
+        size_t res = block.rank + (block.sub >> (9 * w) & 511);
+        if(offset % 64)
+            res += __builtin_popcountll(block.words[w] << (64 - offset % 64));
+        return res;
+    }
+
+    /**
+     * Computes the number of zeros in the
+     * range [0, i) of the bits.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t rank0(const size_t i) const
+    {
+        return i - rank1(i);
+    }
+
+private:
+    static constexpr size_t words_per_block = 6, block_bits = words_per_block * 64;
+
+    // sub packs the number of ones before each word of the block (9 bits each).
+    struct alignas(64) Block
+    {
+        uint64_t rank = 0, sub = 0;
+        uint64_t words[words_per_block] = {};
+    };
+
+    vector<Block> blocks;
+    size_t bits;
+};
+
+/**
+ * Wavelet Matrix.
+ *
+ * Stores a static array of non negative
+ * integers as one Bit Vector per bit of the
+ * values, from the most significant one:
+ * each level holds that bit of every value
+ * and then stably moves the values with a
+ * zero bit before the ones with a one bit.
+ * It answers the kth smallest value and the
+ * number of values less than x (or inside a
+ * range of values) in a subarray without
+ * keeping the array itself, in about
+ * n*log(s)*4/3 bits.
+ *
+ * Time Complexity: O(n*log(s)).
+ * Space Complexity: O(n*log(s)).
+ * Where n is the size of the array and s is the largest value.
+ */
+template<typename T>
+class WaveletMatrix
+{
+    static_assert(is_integral<T>::value, "T must be an integral type.");
+
+public:
+    WaveletMatrix(const vector<T> &arr) :
+        arr_size(arr.size())
+    {
+        T highest = 0;
+        for(const T &value: arr) {
+            assert(value >= 0);
+            highest = max(highest, value);
+        }
+        while(height < 8 * sizeof(T) and (highest >> height) > 0)
+            height++;
+        height = max(height, size_t(1));
+
+        levels.resize(height);
+        zeros.resize(height);
+        vector<T> cur = arr, next(arr_size);
+        for(size_t k = 0; k < height; ++k) {
+            size_t bit = height - 1 - k, z = 0;
+            levels[k] = BitVector(arr_size);
+            for(size_t i = 0; i < arr_size; ++i) {
+                if(cur[i] >> bit & 1)
+                    levels[k].set(i);
+                else
+                    z++;
+            }
+            levels[k].build();
+            zeros[k] = z;
+
+            // stable partition by the bit, zeros first.
+            size_t zi = 0, oi = z;
+            for(size_t i = 0; i < arr_size; ++i)
+                next[(cur[i] >> bit & 1) ? oi++ : zi++] = cur[i];
+            swap(cur, next);
+        }
+    }
+
+    /**
+     * Returns the ith array value.
+     *
+     * Time Complexity: O(log(s)).
+     * Space Complexity: O(1).
+     * Where s is the largest value.
+     */
+    T access(size_t i) const
+    {
+        assert(i < arr_size);
+        T res = 0;
+        for(size_t k = 0; k < height; ++k) {
+            bool b = levels[k][i];
+            res = T(res << 1 | T(b));
+            i = b ? zeros[k] + levels[k].rank1(i) : levels[k].rank0(i);
+        }
+        return res;
+    }
+
+    /**
+     * Finds the kth (0-indexed) smallest value
+     * in the range [l, r] of the array.
+     *
+     * Time Complexity: O(log(s)).
+     * Space Complexity: O(1).
+     * Where s is the largest value.
+     */
+    T kth(size_t l, size_t r, size_t k) const
+    {
+        assert(l <= r and r < arr_size);
+        assert(k <= r - l);
+        r++;
+        T res = 0;
+        for(size_t d = 0; d < height; ++d) {
+            size_t l0 = levels[d].rank0(l), r0 = levels[d].rank0(r);
+            if(k < r0 - l0) {
+                res = T(res << 1);
+                l = l0, r = r0;
+            }
+            else {
+                k -= r0 - l0;
+                res = T(res << 1 | 1);
+                l = zeros[d] + (l - l0), r = zeros[d] + (r - r0);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Counts the values less than x in the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log(s)).
+     * Space Complexity: O(1).
+     * Where s is the largest value.
+     */
+    size_t count_less(size_t l, size_t r, const T x) const
+    {
+        assert(l <= r and r < arr_size);
+        r++;
+        if(x <= 0)
+            return 0;
+        if(height < 8 * sizeof(T) and (x >> height) > 0)
+            return r - l;
+
+        size_t res = 0;
+        for(size_t d = 0; d < height; ++d) {
+            size_t l0 = levels[d].rank0(l), r0 = levels[d].rank0(r);
+            if(x >> (height - 1 - d) & 1) {
+                res += r0 - l0;
+                l = zeros[d] + (l - l0), r = zeros[d] + (r - r0);
+            }
+            else
+                l = l0, r = r0;
+        }
+        return res;
+    }
+
+    /**
+     * Counts the values in the range [lo, hi]
+     * of values in the range [l, r] of the
+     * array.
+     *
+     * Time Complexity: O(log(s)).
+     * Space Complexity: O(1).
+     * Where s is the largest value.
+     */
+    size_t count(const size_t l, const size_t r, const T lo, const T hi) const
+    {
+        assert(lo <= hi);
+        size_t below_hi = (hi == numeric_limits<T>::max() ? r - l + 1 : count_less(l, r, T(hi + 1)));
+        return below_hi - count_less(l, r, lo);
+    }
+
+private:
+    vector<BitVector> levels;
+    vector<size_t> zeros;
+    size_t arr_size, height = 0;
+};
@@ -0,0 +1,195 @@
+#pragma once
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Wide Segment Tree.
+ *
+ * Segment Tree with fanout B = 16 (also
+ * known as S-tree) for the Range Sum,
+ * Min and Max Query kinds. Every node is
+ * an aligned block with the values of its
+ * B children, so a query touches at most
+ * two blocks per level over only
+ * log_B(n) levels (7 for n = 1e8). The
+ * partial blocks are reduced with masks
+ * using GCC vector extensions, which are
+ * compiled to AVX2/SSE instructions when
+ * the target supports them and to scalar
+ * code otherwise.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the array.
+ */
+template<STKind K, typename T>
+class WideSegTree
+{
+    static_assert(K == RSumQ or K == RMinQ or K == RMaxQ, "only sum, min and max kinds are supported.");
+
+public:
+    WideSegTree(const size_t arr_size = 1) :
+        WideSegTree(arr_size, vector<T>(arr_size, neutral_value<T>(K))) {}
+
+    WideSegTree(const vector<T> &arr) :
+        WideSegTree(arr.size(), arr) {}
+
+    WideSegTree(const size_t arr_size, const vector<T> &arr) :
+        arr_size(arr_size)
+    {
+        assert(arr_size > 0 and arr_size <= arr.size());
+        size_t total = 0;
+        for(size_t size = arr_size;; size = (size + B - 1) / B) {
+            offset[height++] = total;
+            total += (size + B - 1) / B;
+            if(size <= B)
+                break;
+        }
+
+        blocks.resize(total);
+        for(Block &block : blocks)
+            for(size_t k = 0; k < B; ++k)
+                block[k] = neutral_value<T>(K);
+        for(size_t i = 0; i < arr_size; ++i)
+            blocks[i / B][i % B] = arr[i];
+        for(size_t k = 0; k + 1 < height; ++k)
+            for(size_t b = 0; b < offset[k + 1] - offset[k]; ++b)
+                blocks[offset[k + 1] + b / B][b % B] = reduce(blocks[offset[k] + b], 0, B - 1);
+    }
+
+    /**
+     * Computes the ith array value.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    T query(const size_t i) const
+    {
+        assert(i < arr_size);
+        return blocks[i / B][i % B];
+    }
+
+    /**
+     * Computes the value corresponding to the
+     * range [l, r] of the array.
+     *
+     * Time Complexity: O(log_B(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    T query(size_t l, size_t r) const
+    {
+        assert(l <= r and r < arr_size);
+        prefetch(l, r);
+
+        T res = neutral_value<T>(K);
+        for(size_t k = 0;; ++k) {
+            const Block *level = &blocks[offset[k]];
+            size_t bl = l / B, br = r / B;
+            if(bl == br)
+                return merge_values<T>(K, res, reduce(level[bl], l % B, r % B));
+
+            res = merge_values<T>(K, res, reduce(level[bl], l % B, B - 1));
+            res = merge_values<T>(K, res, reduce(level[br], 0, r % B));
+            if(bl + 1 == br)
+                return res;
+            l = bl + 1, r = br - 1;
+        }
+    }
+
+    /**
+     * Updates the ith array value adding
+     * delta to it.
+     *
+     * Time Complexity: O(log_B(n)).
+     * Space Complexity: O(1).
+     * Where n is the size of the array.
+     */
+    void update(size_t i, const T delta)
+    {
+        assert(i < arr_size);
+        blocks[i / B][i % B] += delta;
+        for(size_t k = 1; k < height; ++k) {
+            size_t b = i / B;
+            i = b;
+            if(K == RSumQ)
+                blocks[offset[k] + i / B][i % B] += delta;
+            else
+                blocks[offset[k] + i / B][i % B] = reduce(blocks[offset[k - 1] + b], 0, B - 1);
+        }
+    }
+
+private:
+    static constexpr size_t B = 16;
+
+#ifdef __AVX2__
+    static constexpr size_t vector_bytes = 32;
+#else
+    static constexpr size_t vector_bytes = 16;
+#endif
+
+    typedef T Vector __attribute__((vector_size(vector_bytes)));
+
+    static constexpr size_t lanes = vector_bytes / sizeof(T), vectors = B / lanes;
+
+    struct alignas(64) Block
+    {
+        Vector vec[vectors];
+
+        T &operator[](const size_t k)
+        {
+            return vec[k / lanes][k % lanes];
+        }
+
+        T operator[](const size_t k) const
+        {
+            return vec[k / lanes][k % lanes];
+        }
+    };
+
+    static Vector merge_vectors(const Vector &lhs, const Vector &rhs)
+    {
+        switch(K) {
+            case RMaxQ:
+                return lhs > rhs ? lhs : rhs;
+            case RMinQ:
+                return lhs < rhs ? lhs : rhs;
+            default:
+                return lhs + rhs;
+        }
+    }
+
+    // merges the slots in [lo, hi] of a block.
+    static T reduce(const Block &block, const size_t lo, const size_t hi)
+    {
+        alignas(64) static constexpr T iota[B] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+        const Vector neutral = Vector() + neutral_value<T>(K);
+        Vector res = neutral;
+        for(size_t j = 0; j < vectors; ++j) {
+            Vector index;
+            memcpy(&index, iota + j * lanes, vector_bytes);
+            res = merge_vectors(res, ((index >= T(lo)) & (index <= T(hi))) ? block.vec[j] : neutral);
+        }
+
+        T value = res[0];
+        for(size_t k = 1; k < lanes; ++k)
+            value = merge_values<T>(K, value, res[k]);
+        return value;
+    }
+
+    // prefetches the border blocks of every level.
+    void prefetch(size_t l, size_t r) const
+    {
+        for(size_t k = 0; k < height and l <= r; ++k) {
+            __builtin_prefetch(&blocks[offset[k] + l / B]);
+            __builtin_prefetch(&blocks[offset[k] + r / B]);
+            l = l / B + 1, r = r / B;
+            if(r == 0)
+                break;
+            r--;
+        }
+    }
+
+    vector<Block> blocks;
+    size_t arr_size, height = 0, offset[64];
+};
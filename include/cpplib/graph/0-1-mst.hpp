@@ -12,11 +12,15 @@
 // Given an undirected weighted graph such that all nodes are connected
 // except m given pairs.
 // - compute the connected components (the resulting dsu)...
+//
+// The Disjoint Set Union (e.g. DSU or ConcurrentDSU) is a template parameter
+// and the graph is a vector<vector<int> > or a CSR.
 ///
-DSU solve(const vector<vector<int> > &adj1)
+template<typename UnionFind = DSU, typename Graph>
+UnionFind solve(const Graph &adj1)
 {
     int n = adj1.size();
-    DSU dsu(n);
+    UnionFind dsu(n);
 
     set<int> keys;
     map<int, int> cnt;
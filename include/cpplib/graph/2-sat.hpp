@@ -1,22 +1,23 @@
 #pragma once
+#include <cpplib/graph/csr.hpp>
 #include <cpplib/graph/scc.hpp>
 #include <cpplib/stdinc.hpp>
 
-vector<vector<int> > graph(const int n, const vector<pair<int, int> > &disj)
+CSR<> graph(const int n, const vector<pair<int, int> > &disj)
 {
-    vector<vector<int> > adj(2 * n);
+    vector<pair<int, int> > arcs;
+    arcs.reserve(2 * disj.size());
     for(pair<int, int> d: disj) {
-        adj[d.first ^ 1].eb(d.second);
-        adj[d.second ^ 1].eb(d.first);
+        arcs.emplace_back(d.first ^ 1, d.second);
+        arcs.emplace_back(d.second ^ 1, d.first);
     }
-    return adj;
+    return CSR<>(2 * n, arcs);
 }
 
-inline bool check(const vector<vector<int> > &adj)
+template<typename Graph>
+bool check(const Graph &adj)
 {
-    vector<vector<int> > comps;
-    vector<int> repr;
-    tie(comps, repr) = scc(adj);
+    vector<int> repr = get<1>(scc(adj, false));
 
     int n = adj.size();
     for(int i = 0; i < n; i += 2) {
@@ -32,12 +33,11 @@ inline bool check(const int n, const vector<pair<int, int> > &disj)
     return check(graph(n, disj));
 }
 
-inline vector<bool> solve(const vector<vector<int> > &adj)
+template<typename Graph>
+vector<bool> solve(const Graph &adj)
 {
     int n = adj.size();
-    vector<vector<int> > comps;
-    vector<int> repr;
-    tie(comps, repr) = scc(adj);
+    vector<int> repr = get<1>(scc(adj, false));
 
     vector<bool> res(n / 2);
     for(int i = 0; i < n; i += 2) {
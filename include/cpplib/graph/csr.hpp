@@ -0,0 +1,253 @@
+#pragma once
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Compressed Sparse Row Graph.
+ *
+ * Keeps the arcs of a graph sorted by their
+ * origin in a single targets array (and an
+ * optional weights one), where the arcs of
+ * u are in [offsets[u], offsets[u + 1]). It
+ * has the same interface as a
+ * vector<vector<int> > adjacency list
+ * (size() and ranges adj[u]), so the graph
+ * algorithms take either one, but with
+ * three allocations in total and neighbor
+ * scans over contiguous memory.
+ *
+ * Note: the arcs of each vertex keep the
+ * order of the edge list, also when built
+ * by many threads.
+ *
+ * Time Complexity: O(n + m).
+ * Space Complexity: O(n + m).
+ * Where n is the number of vertices and m is the number of arcs.
+ */
+template<typename W = int>
+class CSR
+{
+public:
+    template<typename V>
+    struct Range
+    {
+        const V *first, *last;
+
+        const V *begin() const
+        {
+            return first;
+        }
+
+        const V *end() const
+        {
+            return last;
+        }
+
+        size_t size() const
+        {
+            return last - first;
+        }
+
+        const V &operator[](const size_t i) const
+        {
+            return first[i];
+        }
+    };
+
+    CSR(const int n = 0) :
+        offsets(n + 1, 0) {}
+
+    /**
+     * Builds the graph from a list of arcs
+     * (u, v), or of edges when undirected,
+     * in which case (u, v) also adds (v, u)
+     * right after it.
+     *
+     * Time Complexity: O(n + m/t + t^2).
+     * Space Complexity: O(n + m + t^2).
+     * Where n is the number of vertices, m is the number of arcs and t is the
+     * number of threads.
+     */
+    CSR(const int n, const vector<pair<int, int> > &edges, const bool undirected = false, const size_t threads = 1)
+    {
+        build(n, edges.size(), undirected, false, threads, [&](const size_t k) {
+            return tuple<int, int, W>(edges[k].first, edges[k].second, W());
+        });
+    }
+
+    /**
+     * Builds the weighted graph from a list of
+     * arcs (u, v, w), or of edges when
+     * undirected.
+     *
+     * Time Complexity: O(n + m/t + t^2).
+     * Space Complexity: O(n + m + t^2).
+     * Where n is the number of vertices, m is the number of arcs and t is the
+     * number of threads.
+     */
+    CSR(const int n, const vector<tuple<int, int, W> > &edges, const bool undirected = false, const size_t threads = 1)
+    {
+        build(n, edges.size(), undirected, true, threads, [&](const size_t k) {
+            return edges[k];
+        });
+    }
+
+    /**
+     * Builds the graph from an adjacency list.
+     *
+     * Time Complexity: O(n + m).
+     * Space Complexity: O(n + m).
+     * Where n is the number of vertices and m is the number of arcs.
+     */
+    CSR(const vector<vector<int> > &adj) :
+        offsets(adj.size() + 1, 0)
+    {
+        for(size_t u = 0; u < adj.size(); ++u)
+            offsets[u + 1] = offsets[u] + adj[u].size();
+        targets.reserve(offsets.back());
+        for(const auto &a: adj)
+            targets.insert(targets.end(), all(a));
+    }
+
+    /**
+     * Returns the number of vertices.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    /**
+     * Returns the number of arcs.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    size_t arcs() const
+    {
+        return targets.size();
+    }
+
+    /**
+     * Returns the targets of the arcs of u.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    Range<int> operator[](const int u) const
+    {
+        return {targets.data() + offsets[u], targets.data() + offsets[u + 1]};
+    }
+
+    /**
+     * Returns the weights of the arcs of u,
+     * in the same order as adj[u].
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    Range<W> weight(const int u) const
+    {
+        assert(weights.size() == targets.size());
+        return {weights.data() + offsets[u], weights.data() + offsets[u + 1]};
+    }
+
+private:
+    // counting sort of the arcs by origin. With many threads the arcs are
+    // first split (stably) into buckets of consecutive vertices, then each
+    // thread sorts a bucket.
+    template<typename F>
+    void build(const int n, const size_t m, const bool undirected, const bool weighted, size_t threads, const F &edge)
+    {
+        assert(n > 0 and threads > 0);
+        size_t arc_cnt = (undirected ? 2 : 1) * m;
+        auto arc = [&](const size_t k) {
+            tuple<int, int, W> e = edge(undirected ? k / 2 : k);
+            if(undirected and k % 2 == 1)
+                swap(get<0>(e), get<1>(e));
+            assert(0 <= get<0>(e) and get<0>(e) < n);
+            assert(0 <= get<1>(e) and get<1>(e) < n);
+            return e;
+        };
+        offsets.assign(n + 1, 0);
+        targets.resize(arc_cnt);
+        weights.resize(weighted ? arc_cnt : 0);
+
+        threads = min(threads, size_t(n));
+        if(threads == 1 or arc_cnt < parallel_grain) {
+            for(size_t k = 0; k < arc_cnt; ++k)
+                offsets[get<0>(arc(k)) + 1]++;
+            partial_sum(all(offsets), offsets.begin());
+            vector<size_t> pos(offsets.begin(), offsets.end() - 1);
+            for(size_t k = 0; k < arc_cnt; ++k) {
+                auto e = arc(k);
+                size_t i = pos[get<0>(e)]++;
+                targets[i] = get<1>(e);
+                if(weighted)
+                    weights[i] = get<2>(e);
+            }
+            return;
+        }
+
+        auto bucket = [&](const int u) {
+            return size_t(u) * threads / n;
+        };
+        auto parallel = [&](const function<void(size_t)> &f) {
+            vector<thread> workers;
+            for(size_t t = 0; t < threads; ++t)
+                workers.emplace_back(f, t);
+            for(thread &worker: workers)
+                worker.join();
+        };
+
+        // start[t][b] is where the arcs of thread t in bucket b go.
+        vector<vector<size_t> > start(threads, vector<size_t>(threads, 0));
+        parallel([&](const size_t t) {
+            for(size_t k = t * arc_cnt / threads; k < (t + 1) * arc_cnt / threads; ++k)
+                start[t][bucket(get<0>(arc(k)))]++;
+        });
+        vector<size_t> bucket_start(threads + 1, 0);
+        for(size_t b = 0, total = 0; b < threads; ++b) {
+            bucket_start[b] = total;
+            for(size_t t = 0; t < threads; ++t) {
+                size_t cnt = start[t][b];
+                start[t][b] = total;
+                total += cnt;
+            }
+        }
+        bucket_start[threads] = arc_cnt;
+
+        vector<size_t> order(arc_cnt);
+        parallel([&](const size_t t) {
+            for(size_t k = t * arc_cnt / threads; k < (t + 1) * arc_cnt / threads; ++k)
+                order[start[t][bucket(get<0>(arc(k)))]++] = k;
+        });
+
+        parallel([&](const size_t b) {
+            int lo = (b * n + threads - 1) / threads, hi = ((b + 1) * n + threads - 1) / threads;
+            vector<size_t> pos(hi - lo + 1, 0);
+            for(size_t i = bucket_start[b]; i < bucket_start[b + 1]; ++i)
+                pos[get<0>(arc(order[i])) - lo + 1]++;
+            pos[0] = bucket_start[b];
+            partial_sum(all(pos), pos.begin());
+            copy(pos.begin(), pos.end() - 1, offsets.begin() + lo);
+            for(size_t i = bucket_start[b]; i < bucket_start[b + 1]; ++i) {
+                auto e = arc(order[i]);
+                size_t j = pos[get<0>(e) - lo]++;
+                targets[j] = get<1>(e);
+                if(weighted)
+                    weights[j] = get<2>(e);
+            }
+        });
+        offsets[n] = arc_cnt;
+    }
+
+    // smallest number of arcs which is worth splitting between threads.
+    static constexpr size_t parallel_grain = 1 << 16;
+
+    vector<size_t> offsets;
+    vector<int> targets;
+    vector<W> weights;
+};
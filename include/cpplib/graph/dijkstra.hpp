@@ -0,0 +1,191 @@
+#pragma once
+#include <cpplib/adt/heap.hpp>
+#include <cpplib/graph/csr.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Dijkstra.
+ *
+ * Computes the shortest paths from a set of
+ * sources in a CSR graph with non-negative
+ * weights, keeping the frontier in an
+ * IndexedHeap, so every vertex is in it at
+ * most once. Returns the distances
+ * (numeric_limits<W>::max() for the
+ * unreachable vertices) and the
+ * predecessors (-1 for the sources and the
+ * unreachable vertices).
+ *
+ * Note: given a target, it stops as soon as
+ * the target is settled, so only the
+ * distances up to dis[target] are final.
+ *
+ * Time Complexity: O((n + m)*log(n)).
+ * Space Complexity: O(n).
+ * Where n is the size of the graph and m is the number of arcs.
+ */
+template<typename W>
+tuple<vector<W>, vector<int> > dijkstra(const CSR<W> &adj, const vector<int> &sources, const int target = -1)
+{
+    const W inf = numeric_limits<W>::max();
+    vector<W> dis(adj.size(), inf);
+    vector<int> pred(adj.size(), -1);
+    IndexedHeap<W> pq(adj.size());
+    for(int s: sources) {
+        dis[s] = 0;
+        pq.push(s, 0);
+    }
+    while(!pq.empty()) {
+        int u = pq.top().second;
+        pq.pop();
+        if(u == target)
+            break;
+
+        auto to = adj[u];
+        auto w = adj.weight(u);
+        for(size_t i = 0; i < to.size(); ++i) {
+            assert(w[i] >= 0);
+            int v = to[i];
+            if(dis[u] + w[i] < dis[v]) {
+                dis[v] = dis[u] + w[i];
+                pred[v] = u;
+                pq.push(v, dis[v]);
+            }
+        }
+    }
+    return {dis, pred};
+}
+
+template<typename W>
+tuple<vector<W>, vector<int> > dijkstra(const CSR<W> &adj, const int source, const int target = -1)
+{
+    return dijkstra(adj, vector<int>(1, source), target);
+}
+
+/**
+ * Radix Dijkstra.
+ *
+ * Dijkstra (see above) for non-negative
+ * integer weights, keeping the frontier in
+ * a RadixHeap, which is monotone as the
+ * settled distances are. A vertex may be in
+ * it more than once, the outdated copies
+ * are skipped.
+ *
+ * Time Complexity: O(m + n*log(C)).
+ * Space Complexity: O(n + m).
+ * Where n is the size of the graph, m is the number of arcs and C is the
+ * largest distance.
+ */
+template<typename W>
+tuple<vector<W>, vector<int> > radix_dijkstra(const CSR<W> &adj, const vector<int> &sources, const int target = -1)
+{
+    static_assert(is_integral<W>::value, "W must be integral.");
+    const W inf = numeric_limits<W>::max();
+    vector<W> dis(adj.size(), inf);
+    vector<int> pred(adj.size(), -1);
+    RadixHeap<int> pq;
+    for(int s: sources) {
+        dis[s] = 0;
+        pq.push(0, s);
+    }
+    while(!pq.empty()) {
+        uint64_t d = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
+        if(d != uint64_t(dis[u]))
+            continue;
+        if(u == target)
+            break;
+
+        auto to = adj[u];
+        auto w = adj.weight(u);
+        for(size_t i = 0; i < to.size(); ++i) {
+            assert(w[i] >= 0);
+            int v = to[i];
+            if(dis[u] + w[i] < dis[v]) {
+                dis[v] = dis[u] + w[i];
+                pred[v] = u;
+                pq.push(dis[v], v);
+            }
+        }
+    }
+    return {dis, pred};
+}
+
+template<typename W>
+tuple<vector<W>, vector<int> > radix_dijkstra(const CSR<W> &adj, const int source, const int target = -1)
+{
+    return radix_dijkstra(adj, vector<int>(1, source), target);
+}
+
+/**
+ * Dial.
+ *
+ * Dijkstra (see above) for small integer
+ * weights in [0, C], keeping the frontier
+ * in C + 1 buckets of distances, used
+ * circularly. With weights 0 and 1 it's
+ * the 0-1 BFS.
+ *
+ * Time Complexity: O(n + m + D).
+ * Space Complexity: O(n + m + C).
+ * Where n is the size of the graph, m is the number of arcs, C is the
+ * largest weight and D is the largest distance.
+ */
+template<typename W>
+tuple<vector<W>, vector<int> > dial(const CSR<W> &adj, const vector<int> &sources, const int target = -1)
+{
+    static_assert(is_integral<W>::value, "W must be integral.");
+    const W inf = numeric_limits<W>::max();
+    W c = 0;
+    for(int u = 0; u < (int)adj.size(); ++u)
+        for(W w: adj.weight(u)) {
+            assert(w >= 0);
+            c = max(c, w);
+        }
+
+    vector<W> dis(adj.size(), inf);
+    vector<int> pred(adj.size(), -1);
+    vector<vector<int> > buckets(c + 1);
+    size_t pending = 0;
+    for(int s: sources) {
+        if(dis[s] == 0)
+            continue;
+        dis[s] = 0;
+        buckets[0].emplace_back(s);
+        pending++;
+    }
+    for(W d = 0; pending > 0; ++d) {
+        vector<int> &bucket = buckets[d % (c + 1)];
+        // the vertices settled at d may add more to the same bucket (0 weights).
+        while(!bucket.empty()) {
+            int u = bucket.back();
+            bucket.pop_back();
+            pending--;
+            if(dis[u] != d)
+                continue;
+            if(u == target)
+                return {dis, pred};
+
+            auto to = adj[u];
+            auto w = adj.weight(u);
+            for(size_t i = 0; i < to.size(); ++i) {
+                int v = to[i];
+                if(d + w[i] < dis[v]) {
+                    dis[v] = d + w[i];
+                    pred[v] = u;
+                    buckets[dis[v] % (c + 1)].emplace_back(v);
+                    pending++;
+                }
+            }
+        }
+    }
+    return {dis, pred};
+}
+
+template<typename W>
+tuple<vector<W>, vector<int> > dial(const CSR<W> &adj, const int source, const int target = -1)
+{
+    return dial(adj, vector<int>(1, source), target);
+}
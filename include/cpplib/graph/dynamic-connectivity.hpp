@@ -0,0 +1,184 @@
+#pragma once
+#include <cpplib/adt/dsu.hpp>
+#include <cpplib/stdinc.hpp>
+
+/**
+ * Offline Dynamic Connectivity.
+ *
+ * Answers connectivity queries over a
+ * timeline of edge insertions and
+ * deletions. Every edge is alive during a
+ * range of queries, which is split over
+ * the nodes of a segment tree on the
+ * queries, so a depth first search of that
+ * tree merges the edges of a node in a
+ * RollbackDSU on the way down and undoes
+ * them on the way up.
+ *
+ * Time Complexity: O(n + e + q*log(n) + e*log(q)*log(n)).
+ * Space Complexity: O(n + e*log(q)).
+ * Where n is the number of vertices, e is the number of events and q is the
+ * number of queries.
+ */
+class DynamicConnectivity
+{
+public:
+    DynamicConnectivity(const int n) :
+        n(n) {}
+
+    /**
+     * Adds the edge (a, b), parallel edges
+     * are allowed.
+     *
+     * Time Complexity: O(log(e)).
+     * Space Complexity: O(1).
+     * Where e is the number of events.
+     */
+    void link(int a, int b)
+    {
+        assert(0 <= a and a < n);
+        assert(0 <= b and b < n);
+        if(a > b)
+            swap(a, b);
+        open[{a, b}].emplace_back(queries.size());
+    }
+
+    /**
+     * Removes one of the edges (a, b), which
+     * must be present.
+     *
+     * Time Complexity: O(log(e)).
+     * Space Complexity: O(1).
+     * Where e is the number of events.
+     */
+    void cut(int a, int b)
+    {
+        if(a > b)
+            swap(a, b);
+        auto it = open.find({a, b});
+        assert(it != open.end());
+        add_interval(a, b, it->second.back(), queries.size());
+        it->second.pop_back();
+        if(it->second.empty())
+            open.erase(it);
+    }
+
+    /**
+     * Asks if a and b are connected at this
+     * point of the timeline.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void same(const int a, const int b)
+    {
+        assert(0 <= a and a < n);
+        assert(0 <= b and b < n);
+        queries.emplace_back(a, b);
+    }
+
+    /**
+     * Asks the number of connected components
+     * at this point of the timeline.
+     *
+     * Time Complexity: O(1).
+     * Space Complexity: O(1).
+     */
+    void size()
+    {
+        queries.emplace_back(-1, -1);
+    }
+
+    /**
+     * Answers the queries in the order they
+     * were asked: 0 or 1 for same and the
+     * number of components for size.
+     *
+     * Time Complexity: O(n + q*log(n) + e*log(q)*log(n)).
+     * Space Complexity: O(n + e*log(q)).
+     * Where n is the number of vertices, e is the number of events and q is
+     * the number of queries.
+     */
+    vector<int> solve()
+    {
+        for(auto &e: open)
+            for(int l: e.second)
+                add_interval(e.first.first, e.first.second, l, queries.size());
+        open.clear();
+
+        vector<int> res(queries.size());
+        if(queries.empty())
+            return res;
+
+        // the edges of every node of a bottom-up segment tree over the
+        // queries, stored contiguously (counted first, then filled).
+        for(pw = 1; pw < queries.size(); pw *= 2) {}
+        start.assign(2 * pw + 1, 0);
+        for_each_node([&](const size_t node, const size_t) {
+            start[node + 1]++;
+        });
+        partial_sum(all(start), start.begin());
+        node_edges.resize(start.back());
+        vector<size_t> pos(start.begin(), start.end() - 1);
+        for_each_node([&](const size_t node, const size_t k) {
+            node_edges[pos[node]++] = k;
+        });
+
+        RollbackDSU dsu(n);
+        dfs(1, 0, pw, dsu, res);
+        return res;
+    }
+
+private:
+    // edge (a, b) is alive for the queries in [l, r).
+    void add_interval(const int a, const int b, const size_t l, const size_t r)
+    {
+        if(l < r)
+            intervals.push_back({a, b, l, r});
+    }
+
+    template<typename F>
+    void for_each_node(const F &f) const
+    {
+        for(size_t k = 0; k < intervals.size(); ++k)
+            for(size_t l = intervals[k].l + pw, r = intervals[k].r + pw; l < r; l >>= 1, r >>= 1) {
+                if(l & 1)
+                    f(l++, k);
+                if(r & 1)
+                    f(--r, k);
+            }
+    }
+
+    void dfs(const size_t node, const size_t lo, const size_t hi, RollbackDSU &dsu, vector<int> &res) const
+    {
+        size_t version = dsu.snapshot();
+        for(size_t i = start[node]; i < start[node + 1]; ++i)
+            dsu.merge(intervals[node_edges[i]].a, intervals[node_edges[i]].b);
+
+        if(hi - lo == 1) {
+            int a = queries[lo].first, b = queries[lo].second;
+            res[lo] = (a == -1 ? dsu.size() : dsu.same(a, b));
+        }
+        else {
+            size_t mid = (lo + hi) / 2;
+            dfs(2 * node, lo, mid, dsu, res);
+            if(mid < queries.size())
+                dfs(2 * node + 1, mid, hi, dsu, res);
+        }
+        dsu.rollback(version);
+    }
+
+    struct Interval
+    {
+        int a, b;
+        size_t l, r;
+    };
+
+    int n;
+    size_t pw;
+    map<pair<int, int>, vector<size_t> > open;
+    vector<Interval> intervals;
+    vector<pair<int, int> > queries;
+    vector<size_t> start;
+    vector<uint32_t> node_edges;
+};
@@ -1,42 +1,187 @@
 #pragma once
 #include <cpplib/stdinc.hpp>
 
+// relaxes the bi*bj tile c through the k in [0, bk), given the bi*bk tile a
+// from c's rows and the bk*bj tile b from c's columns (and their
+// predecessors pc and pb), each with its own row stride. k goes first, so
+// c may overlap a or b (as in the diagonal, row and column phases), and
+// the inner loop has no branches, so it vectorizes.
+template<bool Track, typename T>
+void floyd_tile(T *c, int *pc, const size_t ldc, const T *a, const size_t lda, const T *b, const int *pb, const size_t ldb, const size_t bi, const size_t bj, const size_t bk, const T inf)
+{
+    const T eps = (is_floating_point<T>::value ? T(EPS) : T(0));
+    for(size_t k = 0; k < bk; ++k) {
+        const T *brow = b + k * ldb;
+        const int *bpred = (Track ? pb + k * ldb : nullptr);
+        for(size_t i = 0; i < bi; ++i) {
+            T aik = a[i * lda + k];
+            if(!(aik < inf - eps))
+                continue;
+            T *row = c + i * ldc;
+            int *cpred = (Track ? pc + i * ldc : nullptr);
+            for(size_t j = 0; j < bj; ++j) {
+                T value = aik + brow[j];
+                bool better = (brow[j] < inf - eps) & (value < row[j] - eps);
+                row[j] = (better ? value : row[j]);
+                if(Track)
+                    cpred[j] = (better ? bpred[j] : cpred[j]);
+            }
+        }
+    }
+}
+
+template<bool Track, typename T>
+void floyd_blocked(T *dis, int *pred, const size_t n, const T inf, const size_t threads)
+{
+    assert(threads > 0);
+    const size_t block = 64, tiles = (n + block - 1) / block;
+    auto extent = [&](const size_t t) {
+        return min(block, n - t * block);
+    };
+    auto at = [&](const size_t i, const size_t j) {
+        return i * block * n + j * block;
+    };
+    // the tiles which don't overlap the kth row and column are copied
+    // first, since the rows of the matrix map to the same cache sets when n
+    // is a power of two.
+    auto parallel = [&](const size_t k, const vector<pair<size_t, size_t> > &jobs, const bool copy) {
+        auto work = [&](const size_t t) {
+            vector<T> buf(copy ? 3 * block * block : 0);
+            vector<int> pbuf(copy and Track ? 2 * block * block : 0);
+            for(size_t q = t; q < jobs.size(); q += threads) {
+                size_t i = jobs[q].first, j = jobs[q].second, bi = extent(i), bj = extent(j), bk = extent(k);
+                if(!copy) {
+                    floyd_tile<Track>(dis + at(i, j), (Track ? pred + at(i, j) : nullptr), n, dis + at(i, k), n, dis + at(k, j), (Track ? pred + at(k, j) : nullptr), n, bi, bj, bk, inf);
+                    continue;
+                }
+                T *c = buf.data(), *a = c + block * block, *b = a + block * block;
+                int *pc = (Track ? pbuf.data() : nullptr), *pb = (Track ? pc + block * block : nullptr);
+                for(size_t r = 0; r < bi; ++r) {
+                    copy_n(dis + at(i, j) + r * n, bj, c + r * block);
+                    copy_n(dis + at(i, k) + r * n, bk, a + r * block);
+                    if(Track)
+                        copy_n(pred + at(i, j) + r * n, bj, pc + r * block);
+                }
+                for(size_t r = 0; r < bk; ++r) {
+                    copy_n(dis + at(k, j) + r * n, bj, b + r * block);
+                    if(Track)
+                        copy_n(pred + at(k, j) + r * n, bj, pb + r * block);
+                }
+                floyd_tile<Track>(c, pc, block, a, block, b, pb, block, bi, bj, bk, inf);
+                for(size_t r = 0; r < bi; ++r) {
+                    copy_n(c + r * block, bj, dis + at(i, j) + r * n);
+                    if(Track)
+                        copy_n(pc + r * block, bj, pred + at(i, j) + r * n);
+                }
+            }
+        };
+        vector<thread> workers;
+        for(size_t t = 1; t < min(threads, jobs.size()); ++t)
+            workers.emplace_back(work, t);
+        work(0);
+        for(thread &worker: workers)
+            worker.join();
+    };
+
+    // the diagonal tile, then the rest of its row and column, which only
+    // depend on it, then all the others, which depend on those.
+    vector<pair<size_t, size_t> > jobs;
+    for(size_t k = 0; k < tiles; ++k) {
+        parallel(k, {{k, k}}, false);
+
+        jobs.clear();
+        for(size_t t = 0; t < tiles; ++t)
+            if(t != k) {
+                jobs.emplace_back(k, t);
+                jobs.emplace_back(t, k);
+            }
+        parallel(k, jobs, false);
+
+        jobs.clear();
+        for(size_t i = 0; i < tiles; ++i)
+            for(size_t j = 0; j < tiles; ++j)
+                if(i != k and j != k)
+                    jobs.emplace_back(i, j);
+        parallel(k, jobs, true);
+    }
+}
+
 /**
  * Floyd Warshall.
  *
  * Computes the shortest path for all pairs
  * in a weighted graph given its adjacency
- * matrix.
+ * matrix, as n*n row-major values. It's
+ * blocked in 64x64 tiles, so the three
+ * tiles of each step stay in the cache, and
+ * the tiles of each phase are split among
+ * the threads.
  *
  * Note: here we assume the dis parameter
  * as the given adjacency matrix initially
  * and:
- * - dis[i][j] = INF if i and j aren't
+ * - dis[i][j] = inf if i and j aren't
  * adjacents for i,j in [0,n[ and i != j;
- * - dis[i][i] = 0 for i,j in [0,n[.
+ * - dis[i][i] = 0 for i,j in [0,n[;
+ * - 2*inf fits in T.
  *
- * Note: in orther to retrieve the shortest
- * path we can store the predecessor of
- * each vertex when a successful relaxation
- * occurs.
+ * Time Complexity: O(exp(n, 3)/t).
+ * Space Complexity: O(exp(n, 2)).
+ * Where n is the size of the graph and t is the number of threads.
+ */
+template<typename T, typename enable_if<is_arithmetic<T>::value, uint>::type = 0>
+void floyd(vector<T> &dis, const int n, const T inf = LINF, const size_t threads = 1)
+{
+    assert(dis.size() == size_t(n) * n);
+    floyd_blocked<false>(dis.data(), (int *)nullptr, n, inf, threads);
+}
+
+/**
+ * Computes the shortest paths like floyd,
+ * and also pred[i*n + j], the vertex before
+ * j in the shortest path from i to j (or -1
+ * if there's none), to retrieve the paths.
+ *
+ * Note: the tiles are relaxed out of the
+ * plain k order, so with cycles of weight
+ * 0 the predecessors may form a cycle too.
  *
- * Time Complexity: O(exp(n, 3)).
+ * Time Complexity: O(exp(n, 3)/t).
  * Space Complexity: O(exp(n, 2)).
- * Where n is the size of the graph.
+ * Where n is the size of the graph and t is the number of threads.
+ */
+template<typename T, typename enable_if<is_arithmetic<T>::value, uint>::type = 0>
+void floyd(vector<T> &dis, vector<int> &pred, const int n, const T inf = LINF, const size_t threads = 1)
+{
+    assert(dis.size() == size_t(n) * n);
+    const T eps = (is_floating_point<T>::value ? T(EPS) : T(0));
+    pred.assign(size_t(n) * n, -1);
+    for(int i = 0; i < n; ++i)
+        for(int j = 0; j < n; ++j)
+            if(i != j and dis[i * n + j] < inf - eps)
+                pred[i * n + j] = i;
+    floyd_blocked<true>(dis.data(), pred.data(), n, inf, threads);
+}
+
+/**
+ * Computes the shortest path for all pairs
+ * given the adjacency matrix as a
+ * vector<vector<T> > (see floyd above).
+ *
+ * Time Complexity: O(exp(n, 3)/t).
+ * Space Complexity: O(exp(n, 2)).
+ * Where n is the size of the graph and t is the number of threads.
  */
 template<typename T>
-vector<vector<T> > floyd(vector<vector<T> > dis, const T inf = LINF)
+vector<vector<T> > floyd(vector<vector<T> > dis, const T inf = LINF, const size_t threads = 1)
 {
     int n = dis.size();
-    for(int k = 0; k < n; ++k) {
-        for(int i = 0; i < n; ++i) {
-            for(int j = 0; j < n; ++j) {
-                if(dis[i][k] > inf - EPS or dis[k][j] > inf - EPS)
-                    continue;
-                if(dis[i][k] + dis[k][j] <= dis[i][j] - EPS)
-                    dis[i][j] = dis[i][k] + dis[k][j];
-            }
-        }
-    }
+    vector<T> flat;
+    flat.reserve(size_t(n) * n);
+    for(const auto &row: dis)
+        flat.insert(flat.end(), all(row));
+    floyd(flat, n, inf, threads);
+    for(int i = 0; i < n; ++i)
+        copy(flat.begin() + size_t(i) * n, flat.begin() + size_t(i + 1) * n, dis[i].begin());
     return dis;
 }
@@ -1,104 +1,232 @@
 #pragma once
 #include <cpplib/stdinc.hpp>
 
-template<typename SegTree, typename T>
+/**
+ * Heavy Light Decomposition.
+ *
+ * Splits a tree (a vector<vector<int> > or
+ * a CSR) into chains, so that any
+ * path crosses O(log(n)) of them, and lays
+ * them out in a Segment Tree (any tree with
+ * query(l, r) and update(l, r, delta)) so
+ * that every chain and every subtree is a
+ * contiguous range of it.
+ *
+ * Note: Merge folds the values of the
+ * ranges of a path in path order, which is
+ * only enough when the segment folds don't
+ * depend on the direction of the path,
+ * otherwise for_each_path gives the ranges
+ * and their directions.
+ *
+ * Time Complexity: O(n).
+ * Space Complexity: O(n).
+ * Where n is the size of the given tree.
+ */
+template<typename SegTree, typename T, typename Merge = plus<T> >
 class HLD
 {
 public:
-    HLD(const vector<vector<int> > &adj, const vector<T> &values, const int root) :
-        chain_id(adj.size(), -1), id_in_tree(adj.size(), -1), subtree_size(adj.size()), parent(adj.size(), -1)
+    using lazy_type = typename SegTree::lazy_type;
+
+    template<typename Graph>
+    HLD(const Graph &adj, const vector<T> &values, const int root, const Merge &merge = Merge()) :
+        head(adj.size()), id(adj.size()), subtree_size(adj.size(), 1), parent(adj.size(), -1), depth(adj.size()), merge(merge)
     {
-        compute_size(root, adj);
-        vector<T> tree;
-        dfs(root, true, adj, values, tree);
+        decompose(adj, root);
+        vector<T> tree(adj.size());
+        for(size_t u = 0; u < adj.size(); ++u)
+            tree[id[u]] = values[u];
         st = SegTree(tree);
     }
 
-    vector<T> query(const int u)
+    /**
+     * Calls f(l, r, reversed) for every range
+     * [l, r] of the Segment Tree on the path
+     * from u to v, in path order, where
+     * reversed tells if the path goes through
+     * the range from r down to l. It doesn't
+     * allocate any memory.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    template<typename F>
+    void for_each_path(int u, int v, const F &f) const
     {
-        return query(u, u);
+        // the ranges of the v side are found from v up, so they're kept
+        // to be visited backwards (there are less than 64 light edges).
+        pair<int, int> down[64];
+        size_t cnt = 0;
+        while(head[u] != head[v]) {
+            if(depth[head[u]] >= depth[head[v]]) {
+                f(id[head[u]], id[u], true);
+                u = parent[head[u]];
+            }
+            else {
+                assert(cnt < 64);
+                down[cnt++] = {id[head[v]], id[v]};
+                v = parent[head[v]];
+            }
+        }
+        if(id[u] >= id[v])
+            f(id[v], id[u], true);
+        else
+            f(id[u], id[v], false);
+        while(cnt > 0) {
+            cnt--;
+            f(down[cnt].first, down[cnt].second, false);
+        }
     }
 
-    vector<T> query(int u, int v)
+    /**
+     * Computes the value of the node u.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    T query(const int u)
     {
-        vector<T> res;
-        while(chain_id[u] != chain_id[v]) {
-            if(chain_id[u] > chain_id[v])
-                swap(u, v);
-            int head = chain_head[chain_id[v]];
-            res.emplace_back(st.query(id_in_tree[head], id_in_tree[v]));
-            v = parent[head];
-        }
-        if(subtree_size[u] < subtree_size[v])
-            swap(u, v);
-        res.emplace_back(st.query(id_in_tree[u], id_in_tree[v]));
+        return st.query(id[u], id[u]);
+    }
+
+    /**
+     * Computes the fold of the values on the
+     * path from u to v.
+     *
+     * Time Complexity: O(log(n)^2).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    T query(const int u, const int v)
+    {
+        T res = T();
+        bool first = true;
+        for_each_path(u, v, [&](const int l, const int r, const bool) {
+            T value = st.query(l, r);
+            res = (first ? value : merge(res, value));
+            first = false;
+        });
         return res;
     }
 
-    void update(const int u, const T delta)
+    /**
+     * Computes the folds of the values on a
+     * batch of paths from u to v, in input
+     * order.
+     *
+     * Time Complexity: O(q*log(n)^2).
+     * Space Complexity: O(q + log(n)).
+     * Where n is the size of the tree and q is the number of paths.
+     */
+    vector<T> query_batch(const vector<pair<int, int> > &paths)
     {
-        return update(u, u, delta);
+        vector<T> res(paths.size());
+        for(size_t k = 0; k < paths.size(); ++k)
+            res[k] = query(paths[k].first, paths[k].second);
+        return res;
     }
 
-    void update(int u, int v, const T delta)
+    /**
+     * Computes the value corresponding to the
+     * subtree of u.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    T query_subtree(const int u)
     {
-        while(chain_id[u] != chain_id[v]) {
-            if(chain_id[u] > chain_id[v])
-                swap(u, v);
-            int head = chain_head[chain_id[v]];
-            st.update(id_in_tree[head], id_in_tree[v], delta);
-        }
-        if(subtree_size[u] < subtree_size[v])
-            swap(u, v);
-        st.update(id_in_tree[u], id_in_tree[v], delta);
+        return st.query(id[u], id[u] + subtree_size[u] - 1);
     }
 
-private:
-    void compute_size(const int u, const vector<vector<int> > &adj)
+    /**
+     * Updates the value of the node u
+     * according to the Segment Tree.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    void update(const int u, const lazy_type delta)
     {
-        subtree_size[u] = 1;
-        for(int v: adj[u]) {
-            if(v == parent[u])
-                continue;
-            parent[v] = u;
-            compute_size(v, adj);
-            subtree_size[u] += subtree_size[v];
-        }
+        st.update(id[u], id[u], delta);
     }
 
-    void dfs(const int u, const bool new_chain, const vector<vector<int> > &adj, const vector<T> &values, vector<T> &tree)
+    /**
+     * Updates the values on the path from u to
+     * v according to the Segment Tree.
+     *
+     * Time Complexity: O(log(n)^2).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    void update(const int u, const int v, const lazy_type delta)
     {
-        if(new_chain) {
-            chain_id[u] = number_of_chains;
-            chain_head.emplace_back(u);
-            number_of_chains++;
-        }
-        else
-            chain_id[u] = chain_id[parent[u]];
-        id_in_tree[u] = tree.size();
-        tree.emplace_back(values[u]);
+        for_each_path(u, v, [&](const int l, const int r, const bool) {
+            st.update(l, r, delta);
+        });
+    }
+
+    /**
+     * Updates the values in the subtree of u
+     * according to the Segment Tree.
+     *
+     * Time Complexity: O(log(n)).
+     * Space Complexity: O(log(n)).
+     * Where n is the size of the tree.
+     */
+    void update_subtree(const int u, const lazy_type delta)
+    {
+        st.update(id[u], id[u] + subtree_size[u] - 1, delta);
+    }
 
-        int max_size = 0, heavy = -1;
-        for(int v: adj[u]) {
-            if(v == parent[u])
-                continue;
-            if(subtree_size[v] > max_size) {
-                max_size = subtree_size[v];
-                heavy = v;
+private:
+    // iterative, so that deep (e.g. path shaped) trees don't overflow the stack.
+    template<typename Graph>
+    void decompose(const Graph &adj, const int root)
+    {
+        vector<int> order, heavy(adj.size(), -1), stack(1, root);
+        order.reserve(adj.size());
+        while(!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            order.push_back(u);
+            for(int v: adj[u]) {
+                if(v == parent[u])
+                    continue;
+                parent[v] = u;
+                depth[v] = depth[u] + 1;
+                stack.push_back(v);
             }
         }
+        for(size_t i = order.size() - 1; i > 0; --i) {
+            int u = order[i], p = parent[u];
+            subtree_size[p] += subtree_size[u];
+            if(heavy[p] == -1 or subtree_size[u] > subtree_size[heavy[p]])
+                heavy[p] = u;
+        }
 
-        if(heavy != -1)
-            dfs(heavy, false, adj, values, tree);  // heavy edge.
-
-        for(int v: adj[u]) {
-            if(v == parent[u] or v == heavy)
-                continue;
-            dfs(v, true, adj, values, tree);  // light edge.
+        // every chain gets consecutive ids, then the light subtrees hanging
+        // from it (the deepest first), so a subtree is also a range.
+        int next_id = 0;
+        stack.assign(1, root);
+        while(!stack.empty()) {
+            int h = stack.back();
+            stack.pop_back();
+            for(int u = h; u != -1; u = heavy[u]) {
+                head[u] = h;
+                id[u] = next_id++;
+                for(int v: adj[u])
+                    if(v != parent[u] and v != heavy[u])
+                        stack.push_back(v);
+            }
         }
     }
 
-    int number_of_chains = 0;
-    vector<int> chain_id, chain_head, id_in_tree, subtree_size, parent;
+    vector<int> head, id, subtree_size, parent, depth;
+    Merge merge;
     SegTree st;
 };
@@ -1,20 +1,24 @@
 #pragma once
 #include <cpplib/adt/dsu.hpp>
+#include <cpplib/graph/csr.hpp>
 #include <cpplib/stdinc.hpp>
 
 /**
  * Kruskal.
  *
- * Computes the minimum spanning tree.
+ * Computes the minimum spanning tree. The
+ * Disjoint Set Union (e.g. DSU or
+ * ConcurrentDSU) is a template parameter.
  *
  * Time Complexity: O(m*log(n)).
  * Space Complexity: O(n+m).
  * Where n is the size of the graph and m is the number of edges.
  */
+template<typename UnionFind = DSU>
 vector<tuple<int, int, int> > kruskal(const int n, vector<tuple<int, int, int> > edges)
 {
     sort(all(edges));
-    DSU dsu(n);
+    UnionFind dsu(n);
     vector<tuple<int, int, int> > res;
     for(auto &e: edges) {
         int w, u, v;
@@ -24,3 +28,197 @@ vector<tuple<int, int, int> > kruskal(const int n, vector<tuple<int, int, int> >
     }
     return res;
 }
+
+template<typename UnionFind, typename It>
+void filter_kruskal(UnionFind &dsu, const It first, const It last, mt19937 &gen, vector<tuple<int, int, int> > &res)
+{
+    if(dsu.size() == 1)
+        return;
+
+    if(last - first <= 1024) {
+        sort(first, last);
+        for(It e = first; e != last; ++e)
+            if(dsu.merge(get<1>(*e), get<2>(*e)))
+                res.emplace_back(*e);
+        return;
+    }
+
+    // the median of three sampled edges splits them into the lighter,
+    // the equal and the heavier ones.
+    tuple<int, int, int> s[3];
+    for(auto &x: s)
+        x = *(first + gen() % (last - first));
+    sort(s, s + 3);
+    tuple<int, int, int> pivot = s[1];
+    It mid = partition(first, last, [&](const tuple<int, int, int> &e) {
+        return e < pivot;
+    });
+    It heavy = partition(mid, last, [&](const tuple<int, int, int> &e) {
+        return !(pivot < e);
+    });
+
+    filter_kruskal(dsu, first, mid, gen, res);
+    for(It e = mid; e != heavy; ++e)
+        if(dsu.merge(get<1>(*e), get<2>(*e)))
+            res.emplace_back(*e);
+    It end = remove_if(heavy, last, [&](const tuple<int, int, int> &e) {
+        return dsu.same(get<1>(e), get<2>(e));
+    });
+    filter_kruskal(dsu, heavy, end, gen, res);
+}
+
+/**
+ * Filter Kruskal.
+ *
+ * Computes the same minimum spanning tree
+ * as kruskal, but like a quicksort around
+ * sampled pivots which, after the lighter
+ * edges are done, drops the heavier ones
+ * whose ends are already connected, so most
+ * of them are never sorted.
+ *
+ * Time Complexity: O(m + n*log(n)*log(m/n)) expected.
+ * Space Complexity: O(n+m).
+ * Where n is the size of the graph and m is the number of edges.
+ */
+template<typename UnionFind = DSU>
+vector<tuple<int, int, int> > filter_kruskal(const int n, vector<tuple<int, int, int> > edges)
+{
+    UnionFind dsu(n);
+    mt19937 gen(n);
+    vector<tuple<int, int, int> > res;
+    filter_kruskal(dsu, all(edges), gen, res);
+    return res;
+}
+
+/**
+ * Boruvka.
+ *
+ * Computes the same minimum spanning tree
+ * as kruskal (i.e. ties are broken by the
+ * edges order), in rounds which join every
+ * component with its lightest edge and then
+ * contract the components, dropping the
+ * edges inside them. Each round splits the
+ * edges among the threads, which keep the
+ * lightest edge of each component with a
+ * compare-and-swap (after a check against
+ * its lightest weight, so most edges don't
+ * need one).
+ *
+ * Time Complexity: O((n + m/t)*log(n)).
+ * Space Complexity: O(n + m).
+ * Where n is the size of the graph, m is the number of edges and t is the
+ * number of threads.
+ */
+inline vector<tuple<int, int, int> > boruvka(const int n, const vector<tuple<int, int, int> > &edges, const size_t threads = 1)
+{
+    assert(threads > 0);
+    // an edge between the components a and b of the current round.
+    struct Arc
+    {
+        int w, a, b;
+        size_t id;
+    };
+    auto parallel = [&](const size_t cnt, const function<void(size_t, size_t, size_t)> &f) {
+        vector<thread> workers;
+        for(size_t t = 1; t < threads; ++t)
+            workers.emplace_back(f, t, t * cnt / threads, (t + 1) * cnt / threads);
+        f(0, 0, cnt / threads);
+        for(thread &worker: workers)
+            worker.join();
+    };
+
+    vector<Arc> arcs;
+    arcs.reserve(edges.size());
+    for(size_t i = 0; i < edges.size(); ++i)
+        if(get<1>(edges[i]) != get<2>(edges[i]))
+            arcs.push_back({get<0>(edges[i]), get<1>(edges[i]), get<2>(edges[i]), i});
+
+    const size_t none = numeric_limits<size_t>::max();
+    auto lighter = [&](const size_t i, const size_t j) {
+        if(j == none or arcs[i].w != arcs[j].w)
+            return j == none or arcs[i].w < arcs[j].w;
+        return tie(edges[arcs[i].id], arcs[i].id) < tie(edges[arcs[j].id], arcs[j].id);
+    };
+
+    vector<tuple<int, int, int> > res;
+    vector<size_t> kept(threads);
+    for(int k = n; !arcs.empty();) {
+        vector<atomic<int> > best_w(k);
+        vector<atomic<size_t> > best(k);
+        for(int c = 0; c < k; ++c) {
+            best_w[c].store(numeric_limits<int>::max(), memory_order_relaxed);
+            best[c].store(none, memory_order_relaxed);
+        }
+        parallel(arcs.size(), [&](const size_t, const size_t lo, const size_t hi) {
+            for(size_t i = lo; i < hi; ++i)
+                for(int c: {arcs[i].a, arcs[i].b}) {
+                    int w = best_w[c].load(memory_order_relaxed);
+                    if(arcs[i].w > w)
+                        continue;
+                    while(arcs[i].w < w and !best_w[c].compare_exchange_weak(w, arcs[i].w, memory_order_relaxed)) {}
+                    size_t cur = best[c].load(memory_order_relaxed);
+                    while(lighter(i, cur) and !best[c].compare_exchange_weak(cur, i, memory_order_relaxed)) {}
+                }
+        });
+
+        DSU dsu(k);
+        for(int c = 0; c < k; ++c) {
+            size_t i = best[c].load(memory_order_relaxed);
+            if(i != none and dsu.merge(arcs[i].a, arcs[i].b))
+                res.emplace_back(edges[arcs[i].id]);
+        }
+        vector<int> label(k, -1);
+        int next_k = 0;
+        for(int c = 0; c < k; ++c) {
+            int r = dsu.find(c);
+            if(label[r] == -1)
+                label[r] = next_k++;
+            label[c] = label[r];
+        }
+        k = next_k;
+
+        // each thread relabels and compacts its chunk in place.
+        parallel(arcs.size(), [&](const size_t t, const size_t lo, const size_t hi) {
+            size_t cnt = lo;
+            for(size_t i = lo; i < hi; ++i) {
+                Arc arc = arcs[i];
+                arc.a = label[arc.a];
+                arc.b = label[arc.b];
+                if(arc.a != arc.b)
+                    arcs[cnt++] = arc;
+            }
+            kept[t] = cnt - lo;
+        });
+        size_t cnt = 0;
+        for(size_t t = 0; t < threads; ++t) {
+            size_t lo = t * arcs.size() / threads;
+            move(arcs.begin() + lo, arcs.begin() + lo + kept[t], arcs.begin() + cnt);
+            cnt += kept[t];
+        }
+        arcs.resize(cnt);
+    }
+    sort(all(res));
+    return res;
+}
+
+/**
+ * Computes the minimum spanning tree of an
+ * undirected weighted CSR graph (with both
+ * arcs of each edge) by Boruvka.
+ *
+ * Time Complexity: O((n + m/t)*log(n)).
+ * Space Complexity: O(n + m).
+ * Where n is the size of the graph, m is the number of edges and t is the
+ * number of threads.
+ */
+inline vector<tuple<int, int, int> > boruvka(const CSR<int> &adj, const size_t threads = 1)
+{
+    vector<tuple<int, int, int> > edges;
+    for(int u = 0; u < (int)adj.size(); ++u)
+        for(size_t i = 0; i < adj[u].size(); ++i)
+            if(u < adj[u][i])
+                edges.emplace_back(adj.weight(u)[i], u, adj[u][i]);
+    return boruvka(adj.size(), edges, threads);
+}
@@ -4,8 +4,9 @@
 /**
  * Lowest Common Ancestor.
  *
- * Given a tree, computes the LCA of two
- * nodes online.
+ * Given a tree (a vector<vector<int> > or a
+ * CSR), computes the LCA of two nodes
+ * online.
  *
  * Note: it's also usefull to compute
  * distances.
@@ -17,7 +18,8 @@
 class LCA
 {
 public:
-    LCA(const int n, const vector<vector<int> > &adj, const int root) :
+    template<typename Graph>
+    LCA(const int n, const Graph &adj, const int root) :
         tree_size(n), root(root), height(n, -1), _log2(n + 1, 0),
         up(n, vector<int>((int)ceil(log2(n)), -1))
     {
@@ -28,7 +30,8 @@ public:
         preprocess(adj, -1, root);
     }
 
-    LCA(const vector<vector<int> > &adj, const int root) :
+    template<typename Graph>
+    LCA(const Graph &adj, const int root) :
         LCA(adj.size(), adj, root) {}
 
     /**
@@ -88,7 +91,8 @@ public:
     }
 
 private:
-    void preprocess(const vector<vector<int> > &adj, const int p, const int u)
+    template<typename Graph>
+    void preprocess(const Graph &adj, const int p, const int u)
     {
         assert(u < tree_size);
         if(u != root) {
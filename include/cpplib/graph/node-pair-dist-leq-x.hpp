@@ -1,12 +1,13 @@
 #pragma once
-#include <cpplib/adt/segtree.hpp>
+#include <cpplib/adt/fenwick.hpp>
 #include <cpplib/stdinc.hpp>
 
 // Based on 2018 Arab Collegiate Programming Contest (ACPC 2018)
 // problem A, using DSU on tree.
 
 // compute the size of each.
-static void dfs(const vector<vector<int> > &adj, vector<int> &cnt, const int u, const int p)
+template<typename Graph>
+static void dfs(const Graph &adj, vector<int> &cnt, const int u, const int p)
 {
     cnt[u] = 1;
     for(int v: adj[u]) {
@@ -18,38 +19,41 @@ static void dfs(const vector<vector<int> > &adj, vector<int> &cnt, const int u,
 }
 
 // query the number of nodes whose depth <= x.
-static int query(SegTree<RSumQ, int> &st, const int x, const int n)
+static int query(const Fenwick<int> &ft, const int x, const int n)
 {
     if(x >= 0)
-        return st.query(0, min(x, n - 1));
+        return ft.prefix(min(x, n - 1));
     return 0;
 }
 
-// update the depth segtree (adding or removing).
-static void update_st(const vector<vector<int> > &adj, const int u, const int p, SegTree<RSumQ, int> &st, const int pos, const int delta)
+// update the depth fenwick tree (adding or removing).
+template<typename Graph>
+static void update_ft(const Graph &adj, const int u, const int p, Fenwick<int> &ft, const int pos, const int delta)
 {
-    st.update(pos, delta);
+    ft.update(pos, delta);
     for(int v: adj[u]) {
         if(v == p)
             continue;
-        update_st(adj, v, u, st, pos + 1, delta);
+        update_ft(adj, v, u, ft, pos + 1, delta);
     }
 }
 
 // compute the answer on a light subtree.
-static int compute(const vector<vector<int> > &adj, const int u, const int p, SegTree<RSumQ, int> &st, const int bd, const int d, const int x)
+template<typename Graph>
+static int compute(const Graph &adj, const int u, const int p, Fenwick<int> &ft, const int bd, const int d, const int x)
 {
-    int res = query(st, x - d + 2 * bd, adj.size());
+    int res = query(ft, x - d + 2 * bd, adj.size());
     for(int v: adj[u]) {
         if(v == p)
             continue;
-        res += compute(adj, v, u, st, bd, d + 1, x);
+        res += compute(adj, v, u, ft, bd, d + 1, x);
     }
     return res;
 }
 
 // compute the answer on a subtree by putting it as base.
-static int base_at(const vector<vector<int> > &adj, const vector<int> &cnt, queue<pair<int, int> > &light, const int u, const int p, SegTree<RSumQ, int> &st, const int d, const int x)
+template<typename Graph>
+static int base_at(const Graph &adj, const vector<int> &cnt, queue<pair<int, int> > &light, const int u, const int p, Fenwick<int> &ft, const int d, const int x)
 {
     int h = -1;
     for(int v: adj[u]) {
@@ -61,30 +65,31 @@ static int base_at(const vector<vector<int> > &adj, const vector<int> &cnt, queu
 
     int res = 0;
     if(h != -1)
-        res += base_at(adj, cnt, light, h, u, st, d + 1, x);  // solve the heavy and add it to st.
+        res += base_at(adj, cnt, light, h, u, ft, d + 1, x);  // solve the heavy and add it to ft.
 
-    // now u is the base and h (the heavy) is already in the st.
+    // now u is the base and h (the heavy) is already in the ft.
     for(int v: adj[u]) {
         if(v == p or v == h)
             continue;
-        res += compute(adj, v, u, st, d, d + 1, x);  // compute ans between light and heavy,
+        res += compute(adj, v, u, ft, d, d + 1, x);  // compute ans between light and heavy,
 
-        update_st(adj, v, u, st, d + 1, 1);  // add light to st (so we can compute between light and light in st).
+        update_ft(adj, v, u, ft, d + 1, 1);  // add light to ft (so we can compute between light and light in ft).
 
         light.ep(v, u);  // add light subtree to compute later.
     }
 
-    // now everyone (except u) in this subtree is in the st,
+    // now everyone (except u) in this subtree is in the ft,
     // now we need to compute the as for our base.
-    res += query(st, x + d, adj.size());
+    res += query(ft, x + d, adj.size());
 
-    st.update(d, 1);  // add current to st.
+    ft.update(d, 1);  // add current to ft.
     return res;
 }
 
 // compute the number of distinct vertices of a tree such that their distance <= x.
 // O(n*exp(log(n), 2)).
-int solve(const vector<vector<int> > &adj, const int x)
+template<typename Graph>
+int solve(const Graph &adj, const int x)
 {
     int n = adj.size();
     if(x <= 0)
@@ -96,15 +101,15 @@ int solve(const vector<vector<int> > &adj, const int x)
     queue<pair<int, int> > light;
     light.ep(0, -1);
 
-    SegTree<RSumQ, int> st(n);
+    Fenwick<int> ft(n);
 
     int res = 0;
     while(!light.empty()) {
         int u = light.front().ff, p = light.front().ss;
         light.pop();
 
-        res += base_at(adj, cnt, light, u, p, st, 0, x);
-        update_st(adj, u, p, st, 0, -1);  // remove the subtree from st.
+        res += base_at(adj, cnt, light, u, p, ft, 0, x);
+        update_ft(adj, u, p, ft, 0, -1);  // remove the subtree from ft.
     }
     return res;
 }
@@ -1,66 +1,103 @@
 #pragma once
 #include <cpplib/stdinc.hpp>
 
-inline void dfs(const vector<vector<int> > &adj, vector<bool> &vis, vector<int> &order, const int u)
-{
-    vis[u] = true;
-    for(int v: adj[u]) {
-        if(vis[v])
-            continue;
-        dfs(adj, vis, order, v);
-    }
-    order.emplace_back(u);
-}
-
-tuple<vector<vector<int> >, vector<int> > scc(const vector<vector<int> > &adj)
+/**
+ * Strongly Connected Components.
+ *
+ * Computes the component of every vertex of
+ * a directed graph (a vector<vector<int> >
+ * or a CSR), numbered in topological order,
+ * and optionally the condensation. It's
+ * Pearce's iterative version of Tarjan's
+ * algorithm, so long paths don't overflow
+ * the stack and, besides the condensation,
+ * it only keeps O(n) words (no reversed
+ * graph).
+ *
+ * Time Complexity: O(n + m).
+ * Space Complexity: O(n + m).
+ * Where n is the size of the graph and m is the number of arcs.
+ */
+template<typename Graph>
+tuple<vector<vector<int> >, vector<int> > scc(const Graph &adj, const bool condense = true)
 {
     int n = adj.size();
     assert(n > 0);
-    vector<vector<int> > iadj(n);
-    for(int i = 0; i < n; ++i) {
-        for(int j: adj[i])
-            iadj[j].eb(i);
-    }
-
-    vector<int> order;
-
-    vector<bool> vis(n);
-    for(int i = 0; i < n; ++i) {
-        if(!vis[i])
-            dfs(adj, vis, order, i);
-    }
-    reverse(all(order));
 
-    int k = 0;
-    vector<int> repr(n, -1);
-    queue<int> q;
-    for(int i: order) {
-        if(repr[i] != -1)
+    // rindex is the dfs index of a vertex on the stack (lowered to the
+    // smallest one it reaches) and, once its component is done, the
+    // component id, which counts down from n - 1.
+    vector<int> rindex(n, 0), stack;
+    vector<bool> root(n);
+    vector<pair<int, size_t> > calls;
+    int index = 1, c = n - 1;
+    for(int s = 0; s < n; ++s) {
+        if(rindex[s] != 0)
             continue;
 
-        q.emplace(i);
-        repr[i] = k;
-        while(!q.empty()) {
-            int u = q.front();
-            q.pop();
-            for(int v: iadj[u]) {
-                if(repr[v] != -1)
+        rindex[s] = index++;
+        root[s] = true;
+        calls.emplace_back(s, 0);
+        while(!calls.empty()) {
+            int v = calls.back().first;
+            size_t &i = calls.back().second;
+            if(i < adj[v].size()) {
+                int w = adj[v][i];
+                if(rindex[w] == 0) {
+                    rindex[w] = index++;
+                    root[w] = true;
+                    calls.emplace_back(w, 0);
                     continue;
-                q.emplace(v);
-                repr[v] = k;
+                }
+                if(rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    root[v] = false;
+                }
+                i++;
+                continue;
+            }
+
+            calls.pop_back();
+            if(root[v]) {
+                index--;
+                while(!stack.empty() and rindex[v] <= rindex[stack.back()]) {
+                    rindex[stack.back()] = c;
+                    stack.pop_back();
+                    index--;
+                }
+                rindex[v] = c--;
+            }
+            else
+                stack.emplace_back(v);
+
+            // back in the parent, v is done as its ith successor.
+            if(!calls.empty()) {
+                int p = calls.back().first;
+                if(rindex[v] < rindex[p]) {
+                    rindex[p] = rindex[v];
+                    root[p] = false;
+                }
+                calls.back().second++;
             }
         }
-        k++;
     }
 
-    vector<vector<int> > res(k);
-    for(int i = 0; i < n; ++i) {
-        for(int j: adj[i]) {
-            int u = repr[i], v = repr[j];
-            if(u == v)
-                continue;
-            res[u].eb(v);
+    // the first components found are sinks, so they get the last ids.
+    int k = n - 1 - c;
+    for(int &r: rindex)
+        r -= c + 1;
+
+    vector<vector<int> > res;
+    if(condense) {
+        res.resize(k);
+        for(int i = 0; i < n; ++i) {
+            for(int j: adj[i]) {
+                int u = rindex[i], v = rindex[j];
+                if(u == v)
+                    continue;
+                res[u].eb(v);
+            }
         }
     }
-    return {res, repr};
+    return {res, rindex};
 }
@@ -1,7 +1,8 @@
 #pragma once
 #include <cpplib/stdinc.hpp>
 
-inline static tuple<int, int> bfs(vector<vector<int> > &adj, int s)
+template<typename Graph>
+static tuple<int, int> bfs(const Graph &adj, int s)
 {
     queue<tuple<int, int, int> > q;
     q.emplace(0, s, -1);
@@ -23,7 +24,8 @@ inline static tuple<int, int> bfs(vector<vector<int> > &adj, int s)
     return {res, d};
 }
 
-tuple<int, int, int> tree_diameter(vector<vector<int> > &adj)
+template<typename Graph>
+tuple<int, int, int> tree_diameter(const Graph &adj)
 {
     int ini = get<0>(bfs(adj, 0)), end, dis;
     tie(end, dis) = bfs(adj, ini);
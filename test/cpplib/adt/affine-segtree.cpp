@@ -0,0 +1,12 @@
+#include <cpplib/adt/affine-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    AffineSegTree<montgomery<998244353> > st(vector<montgomery<998244353> >{1, 2, 3});
+    st.affine(0, 1, 2, 1);
+    debug(st.query(0, 2));
+    st.set(1, 2, 5);
+    debug(st.query(0, 2));
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include <cpplib/adt/affine-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://judge.yosupo.jp/problem/range_affine_range_sum
+    desync();
+    int n, q;
+    cin >> n >> q;
+
+    using mm = montgomery<998244353>;
+    vector<mm> arr(n);
+    for(mm &x: arr) {
+        int v;
+        cin >> v;
+        x = v;
+    }
+    AffineSegTree<mm> st(arr);
+    while(q--) {
+        int t, l, r;
+        cin >> t >> l >> r;
+        if(t == 0) {
+            int b, c;
+            cin >> b >> c;
+            st.affine(l, r - 1, b, c);
+        }
+        else
+            cout << st.query(l, r - 1) << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+#include <cpplib/adt/concurrent-dsu.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    int sz = 1000;
+    vector<pair<int, int> > links;
+    for(int i = 1; i < sz; i += 2)
+        links.emplace_back(i - 1, i);
+    for(int i = 2; i < sz; i += 4)
+        links.emplace_back(i - 1, i);
+    ConcurrentDSU dsu(sz, links, 4);
+    assert(dsu.size() == sz / 4);
+    assert(dsu.same(0, 3) and !dsu.same(3, 4));
+    assert(dsu.size(5) == 4);
+    debug(dsu.find(7));
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <cpplib/adt/concurrent-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    ConcurrentSegTree<RSumQ, int> st;
+    debug(st.query(0));
+    st.update(0, 1);
+    debug(st.query(0));
+
+    ConcurrentSegTree<RMinQ, int> mst(vi(8, 5));
+    vector<thread> writers;
+    for(int w = 0; w < 4; ++w)
+        writers.emplace_back([&mst, w] {
+            for(int i = 0; i < 8; ++i)
+                mst.update(i, -w);
+        });
+    for(thread &writer: writers)
+        writer.join();
+    assert(mst.query(0, 7) == -1);
+    debug(mst.contention());
+
+    // writers with deltas of both signs on a few leaves, so the refreshes
+    // race, and then every range must match the final leaves.
+    auto stress = [](auto &st, const size_t n, const auto &pick) {
+        vector<thread> writers;
+        for(int w = 0; w < 3; ++w)
+            writers.emplace_back([&st, n, w] {
+                mt19937 rng(w);
+                for(int i = 0; i < 100000; ++i)
+                    st.update(rng() % n, int(rng() % 7) - 3);
+            });
+        for(thread &writer: writers)
+            writer.join();
+        for(size_t l = 0; l < n; ++l) {
+            int res = st.query(l);
+            for(size_t r = l; r < n; ++r) {
+                res = pick(res, st.query(r));
+                assert(st.query(l, r) == res);
+            }
+        }
+    };
+    for(size_t n: {2, 3, 4, 5}) {
+        ConcurrentSegTree<RMinQ, int> lo(vi(n, 2));
+        stress(lo, n, [](int a, int b) { return min(a, b); });
+        ConcurrentSegTree<RMaxQ, int> hi(vi(n, 2));
+        stress(hi, n, [](int a, int b) { return max(a, b); });
+    }
+    return 0;
+}
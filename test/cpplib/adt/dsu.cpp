@@ -9,5 +9,12 @@ int32_t main()
         for(int j = 0; j < sz; ++j)
             dsu.merge(i, j);
     }
+
+    RollbackDSU rdsu(sz);
+    size_t version = rdsu.snapshot();
+    for(int i = 1; i < sz; ++i)
+        rdsu.merge(i - 1, i);
+    rdsu.rollback(version);
+    debug(rdsu.size(), rdsu.same(0, 1));
     return 0;
 }
@@ -0,0 +1,90 @@
+#include <cpplib/adt/dynamic-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    DynamicSegTree<RSumQ, int> st;
+    st.update(1000000000000000000, 1);
+    st.update(0, 1000000000000000000, 2);
+    assert(st.query(0, 1000000000000000000) == 2000000000000000003);
+    assert(st.query(1000000000000000000) == 3);
+    debug(st.nodes());
+
+    DynamicSegTreeS<RMinQ, int> sst(1000);
+    sst.set(10, 20, 5);
+    sst.update(15, 999, -1);
+    assert(sst.query(0, 999) == 4);
+    assert(sst.query(10, 14) == 5);
+    assert(sst.find(4) == 15);
+
+    // the reads go through the pending lazies without creating nodes.
+    size_t nodes = sst.nodes();
+    const DynamicSegTreeS<RMinQ, int> &csst = sst;
+    for(size_t i = 0; i < 1000; i += 7) {
+        assert(csst.query(i) == (i < 10 ? csst.query(0) : i < 15 ? 5 : i <= 20 ? 4 : csst.query(999)));
+        assert(csst.find(4, i / 2, i, i % 2 == 0) == (i < 15 or i / 2 > 20 ? 1000 : i % 2 == 0 ? max(size_t(15), i / 2) : min(size_t(20), i)));
+    }
+    assert(sst.nodes() == nodes);
+
+    // overlapping range adds over a huge array (small enough for the sums
+    // to fit), against the sum of the overlaps of every add with the query.
+    mt19937_64 rng(1);
+    const size_t big = size_t(1) << 40;
+    DynamicSegTree<RSumQ, int> hst;
+    vector<tuple<size_t, size_t, int> > adds;
+    for(int q = 0; q < 2000; ++q) {
+        size_t l = rng() % big, r = rng() % big;
+        if(l > r)
+            swap(l, r);
+        if(q % 2 == 0) {
+            int delta = int(rng() % 21) - 10;
+            adds.emplace_back(l, r, delta);
+            hst.update(l, r, delta);
+            continue;
+        }
+        int sum = 0;
+        for(auto &[al, ar, delta]: adds)
+            if(max(l, al) <= min(r, ar))
+                sum += delta * int(min(r, ar) - max(l, al) + 1);
+        assert(hst.query(l, r) == sum);
+    }
+    nodes = hst.nodes();
+    for(int q = 0; q < 1000; ++q) {
+        size_t l = rng() % big, r = rng() % big;
+        hst.query(min(l, r), max(l, r));
+    }
+    assert(hst.nodes() == nodes);
+
+    // sets and adds against a brute force array.
+    for(int it = 0; it < 100; ++it) {
+        size_t n = rng() % 50 + 1;
+        vi arr(n, 0);
+        DynamicSegTreeS<RSumQ, int> sum(n);
+        DynamicSegTreeS<RMinQ, int> lo(n);
+        sum.set(0, n - 1, 0);
+        lo.set(0, n - 1, 0);
+        for(int q = 0; q < 100; ++q) {
+            size_t l = rng() % n, r = rng() % n;
+            if(l > r)
+                swap(l, r);
+            int x = int(rng() % 21) - 10, op = rng() % 3;
+            for(size_t i = l; i <= r; ++i)
+                arr[i] = (op == 0 ? x : op == 1 ? arr[i] + x : arr[i]);
+            if(op == 0) {
+                sum.set(l, r, x);
+                lo.set(l, r, x);
+            }
+            else if(op == 1) {
+                sum.update(l, r, x);
+                lo.update(l, r, x);
+            }
+            else {
+                assert(sum.query(l, r) == accumulate(arr.begin() + l, arr.begin() + r + 1, 0LL));
+                assert(lo.query(l, r) == *min_element(arr.begin() + l, arr.begin() + r + 1));
+                size_t first = find_if(arr.begin() + l, arr.begin() + r + 1, [x](int v) { return v <= x; }) - arr.begin();
+                assert(lo.find(x, l, r) == (first <= r ? first : n));
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <cpplib/adt/fenwick.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    Fenwick<int> ft(vi{1, 0, 2, 1});
+    assert(ft.query(1, 3) == 3);
+    ft.update(1, 1);
+    assert(ft.prefix(1) == 2);
+    debug(ft.lower_bound(3));
+
+    FenwickRU<int> rft(4);
+    rft.update(1, 2, 3);
+    assert(rft.query(0, 3) == 6);
+
+    Fenwick2D<int> mft(2, 2);
+    mft.update(1, 1, 1);
+    assert(mft.query(0, 1, 0, 1) == 1);
+
+    OfflineFenwick2D<int> oft({{1, 1000000000}, {-5, 3}, {7, 7}});
+    oft.update(-5, 3, 2);
+    oft.update(7, 7, 1);
+    assert(oft.query(-10, 7, 0, 10) == 3);
+    assert(oft.query(-5, -5, 3, 3) == 2);
+    assert(oft.query(-4, 6, -1000000000, 1000000000) == 0);
+
+    // points with negative coordinates, shared coordinates and repeated
+    // points, against a brute force over the updates.
+    mt19937 rng(1);
+    for(int it = 0; it < 50; ++it) {
+        vector<pair<int, int> > points(rng() % 30 + 1);
+        for(auto &p: points)
+            p = {int(rng() % 21) - 10, int(rng() % 21) - 10};
+        for(int k = rng() % 5; k > 0; --k)
+            points.push_back(points[rng() % points.size()]);
+        OfflineFenwick2D<int> bft(points);
+        map<pair<int, int>, int> value;
+        for(int q = 0; q < 200; ++q) {
+            if(q % 2 == 0) {
+                auto p = points[rng() % points.size()];
+                int delta = int(rng() % 21) - 10;
+                value[p] += delta;
+                bft.update(p.first, p.second, delta);
+                continue;
+            }
+            int x1 = int(rng() % 25) - 12, x2 = int(rng() % 25) - 12, y1 = int(rng() % 25) - 12, y2 = int(rng() % 25) - 12;
+            if(x1 > x2)
+                swap(x1, x2);
+            if(y1 > y2)
+                swap(y1, y2);
+            int sum = 0;
+            for(auto &e: value)
+                if(x1 <= e.first.first and e.first.first <= x2 and y1 <= e.first.second and e.first.second <= y2)
+                    sum += e.second;
+            assert(bft.query(x1, x2, y1, y2) == sum);
+        }
+    }
+    return 0;
+}
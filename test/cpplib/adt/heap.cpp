@@ -5,5 +5,29 @@ int32_t main()
 {
     max_heap<int> pq1;
     min_heap<int> pq2;
+
+    IndexedHeap<int> pq3(5);
+    pq3.push(0, 7);
+    pq3.push(1, 3);
+    pq3.push(2, 5);
+    pq3.push(0, 1);
+    pq3.push(1, 9);
+    assert(pq3.size() == 3 and pq3.top().first == 1 and pq3.top().second == 0);
+    pq3.pop();
+    assert(!pq3.contains(0) and pq3.top().second == 2);
+    pq3.pop();
+    assert(pq3.top().first == 9);
+
+    RadixHeap<int> pq4;
+    pq4.push(10, 0);
+    pq4.push(3, 1);
+    pq4.push(3, 2);
+    assert(pq4.top().first == 3);
+    pq4.pop();
+    pq4.push(4, 3);
+    pq4.pop();
+    assert(pq4.top().first == 4 and pq4.top().second == 3);
+    pq4.pop();
+    assert(pq4.size() == 1 and pq4.top().second == 0);
     return 0;
 }
@@ -0,0 +1,10 @@
+#include <cpplib/adt/merge-sort-tree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    MergeSortTree<int> mst({5, 1, 4, 1, 3});
+    debug(mst.kth(0, 4, 2));
+    debug(mst.count_less(1, 3, 4));
+    return 0;
+}
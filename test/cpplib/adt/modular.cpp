@@ -7,5 +7,9 @@ int32_t main()
     i += j;
     j += k;
     k += i;
+
+    montgomery<998244353> a = 10, b = -3;
+    a *= b;
+    debug(exp(a, 5) - b);
     return 0;
 }
@@ -0,0 +1,59 @@
+#include <cpplib/adt/persistent-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    PersistentSegTree<RSumQ, int> st(vi{1, 2, 3});
+    st.update(0, 1, 5);
+    assert(st.query(0, 0, 2) == 6);
+    assert(st.query(1, 0, 2) == 11);
+    assert(st.versions() == 2);
+
+    // counts the values 0..3 after each prefix of {2, 0, 3, 2}.
+    PersistentSegTree<RSumQ, int> cnt(4);
+    vi arr = {2, 0, 3, 2};
+    for(size_t i = 0; i < arr.size(); ++i)
+        cnt.update(i, arr[i], 1);
+    assert(cnt.kth(1, 4, 1) == 2);  // 2nd smallest in {0, 3, 2}.
+    assert(cnt.kth(1, 4, 3) == 4);
+
+    // updates branching from random old versions, all kept in full.
+    mt19937 rng(1);
+    for(int it = 0; it < 50; ++it) {
+        size_t n = rng() % 20 + 1;
+        vvi snap(1, vi(n));
+        for(int &x: snap[0])
+            x = int(rng() % 21) - 10;
+        PersistentSegTree<RMinQ, int> mst(snap[0]);
+        for(int q = 0; q < 100; ++q) {
+            size_t v = rng() % snap.size(), i = rng() % n;
+            int delta = int(rng() % 21) - 10;
+            snap.push_back(snap[v]);
+            snap.back()[i] += delta;
+            assert(mst.update(v, i, delta) == snap.size() - 1);
+
+            size_t u = rng() % snap.size(), l = rng() % n, r = rng() % n;
+            if(l > r)
+                swap(l, r);
+            assert(mst.query(u, l, r) == *min_element(snap[u].begin() + l, snap[u].begin() + r + 1));
+            assert(mst.query(u, i) == snap[u][i]);
+        }
+    }
+
+    // kth smallest of every subarray, as the difference of two versions.
+    size_t n = 60, values = 25;
+    vi a(n);
+    PersistentSegTree<RSumQ, int> freq(values);
+    for(size_t i = 0; i < n; ++i) {
+        a[i] = rng() % values;
+        freq.update(i, a[i], 1);
+    }
+    for(size_t l = 0; l < n; ++l)
+        for(size_t r = l + 1; r <= n; ++r) {
+            vi sorted(a.begin() + l, a.begin() + r);
+            sort(all(sorted));
+            for(size_t k = 0; k <= sorted.size(); ++k)
+                assert(freq.kth(l, r, k) == (k < sorted.size() ? size_t(sorted[k]) : values));
+        }
+    return 0;
+}
@@ -0,0 +1,16 @@
+#include <cpplib/adt/rmq.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    vi arr = {3, 1, 4, 1, 5};
+    RMQ<int> rmq(arr);
+    debug(rmq.query(0, 4));
+
+    RMQ<int, RMQMax<int> > max_rmq(arr);
+    debug(max_rmq.query(1, 2));
+
+    LinearRMQ<int, greater<int> > lrmq(arr);
+    debug(lrmq.query(2, 4));
+    return 0;
+}
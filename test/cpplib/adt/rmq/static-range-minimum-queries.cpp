@@ -0,0 +1,24 @@
+#include <cpplib/adt/rmq.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://cses.fi/problemset/task/1647
+    desync();
+    int n, q;
+    cin >> n >> q;
+    vi arr(n);
+    for(auto &i: arr)
+        cin >> i;
+    RMQ<int> rmq(arr);
+    LinearRMQ<int> lrmq(arr);
+    while(q--) {
+        int a, b;
+        cin >> a >> b;
+        a--;
+        b--;
+        assert(rmq.query(a, b) == lrmq.query(a, b));
+        cout << lrmq.query(a, b) << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <cpplib/adt/segtree-beats.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    SegTreeBeats<int> st(vi{5, 1, 4, 2, 3});
+    st.chmin(0, 4, 3);
+    assert(st.query(0, 4) == 12);
+    st.chmax(1, 3, 2);
+    st.add(0, 1, 1);
+    assert(st.query_max(0, 4) == 4);
+    assert(st.query_min(0, 4) == 2);
+
+    // the extreme values fail the tag condition even at the leaves.
+    SegTreeBeats<int> hi(vi{1}), lo(vi{-1});
+    hi.chmax(0, 0, numeric_limits<int>::max());
+    assert(hi.query(0, 0) == numeric_limits<int>::max());
+    lo.chmin(0, 0, numeric_limits<int>::lowest());
+    assert(lo.query_min(0, 0) == numeric_limits<int>::lowest());
+
+    // against a brute force, mixing chmin, chmax and add.
+    mt19937 rng(1);
+    for(int it = 0; it < 300; ++it) {
+        int n = rng() % 40 + 1;
+        vi arr(n);
+        for(int &x: arr)
+            x = int(rng() % 41) - 20;
+        SegTreeBeats<int> bt(arr);
+        for(int q = 0; q < 100; ++q) {
+            int l = rng() % n, r = rng() % n, x = int(rng() % 41) - 20;
+            if(l > r)
+                swap(l, r);
+            int op = rng() % 4;
+            for(int i = l; i <= r; ++i)
+                arr[i] = (op == 0 ? min(arr[i], x) : op == 1 ? max(arr[i], x) : op == 2 ? arr[i] + x : arr[i]);
+            if(op == 0)
+                bt.chmin(l, r, x);
+            else if(op == 1)
+                bt.chmax(l, r, x);
+            else if(op == 2)
+                bt.add(l, r, x);
+            else {
+                assert(bt.query(l, r) == accumulate(arr.begin() + l, arr.begin() + r + 1, 0LL));
+                assert(bt.query_min(l, r) == *min_element(arr.begin() + l, arr.begin() + r + 1));
+                assert(bt.query_max(l, r) == *max_element(arr.begin() + l, arr.begin() + r + 1));
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include <cpplib/adt/segtree-beats.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // http://acm.hdu.edu.cn/showproblem.php?pid=5306
+    desync();
+    int t;
+    cin >> t;
+    while(t--) {
+        int n, m;
+        cin >> n >> m;
+        vi arr(n);
+        for(auto &i: arr)
+            cin >> i;
+        SegTreeBeats<int> st(arr);
+        while(m--) {
+            int op, x, y;
+            cin >> op >> x >> y;
+            if(op == 0) {
+                int v;
+                cin >> v;
+                st.chmin(x - 1, y - 1, v);
+            }
+            else if(op == 1)
+                cout << st.query_max(x - 1, y - 1) << endl;
+            else
+                cout << st.query(x - 1, y - 1) << endl;
+        }
+    }
+    return 0;
+}
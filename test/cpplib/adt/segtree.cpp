@@ -3,9 +3,88 @@
 
 int32_t main()
 {
+    static_assert(is_trivially_copyable<STNode<RSumQ, int>>::value, "nodes must be trivially copyable.");
+
     SegTree<RSumQ, int> st;
     debug(st.query(0));
     st.update(0, 1);
     debug(st.query(0));
+    debug(st.max_right(0, [](int v) { return v < 1; }));
+    debug(st.min_left(0, [](int v) { return v < 1; }));
+
+    vi arr = {3, 1, 4, 1, 5};
+    SegTree<RSumQ, int> pst(arr, 2);
+    pst.assign(arr.begin(), arr.end(), 2);
+    pst.assign({{1, 2}, {4, 6}}, 2);
+    assert(pst.query(0, 4) == 16);
+    pst.update_batch({{0, 2}, {1, 4}}, {1, 2});
+    assert(pst.query_batch({{0, 4}, {2, 2}}) == vi({27, 7}));
+
+    // big enough for query_batch to walk the ranges in groups.
+    mt19937 rng(1);
+    size_t n = 300000;
+    vi big(n);
+    for(int &x: big)
+        x = int(rng() % 2001) - 1000;
+    vector<pair<size_t, size_t> > ranges;
+    for(int k = 0; k < 20000; ++k) {
+        size_t l = rng() % n, r = (k % 4 == 0 ? l : rng() % n);
+        ranges.emplace_back(min(l, r), max(l, r));
+    }
+    ranges.emplace_back(0, n - 1);
+    ranges.emplace_back(n - 1, n - 1);
+    SegTree<RSumQ, int> sst(big);
+    SegTree<RMinQ, int> mst(big);
+    vi sres = sst.query_batch(ranges), mres = mst.query_batch(ranges);
+    for(size_t k = 0; k < ranges.size(); ++k) {
+        assert(sres[k] == sst.query(ranges[k].first, ranges[k].second));
+        assert(mres[k] == mst.query(ranges[k].first, ranges[k].second));
+    }
+
+    // above the parallel grain, so the threaded build and assigns split the
+    // work, the second assign over ranges with pending lazies.
+    auto check = [&](auto &seq, auto &par, const vi &values) {
+        for(size_t i = 0; i < n; ++i)
+            assert(seq.query(i) == values[i] and par.query(i) == values[i]);
+        for(auto &range: ranges)
+            assert(seq.query(range.first, range.second) == par.query(range.first, range.second));
+    };
+    SegTree<RSumQ, int> sseq(big), spar(big, 4);
+    SegTree<RMinQ, int> mseq(big), mpar(big, 4);
+    check(sseq, spar, big);
+    check(mseq, mpar, big);
+
+    for(int &x: big)
+        x = int(rng() % 2001) - 1000;
+    sseq.assign(big.begin(), big.end());
+    spar.assign(big.begin(), big.end(), 4);
+    mseq.assign(big.begin(), big.end());
+    mpar.assign(big.begin(), big.end(), 4);
+    check(sseq, spar, big);
+    check(mseq, mpar, big);
+
+    for(int k = 0; k < 100; ++k) {
+        size_t l = rng() % n, r = rng() % n;
+        int delta = rng() % 11;
+        if(l > r)
+            swap(l, r);
+        for(size_t i = l; i <= r; ++i)
+            big[i] += delta;
+        sseq.update(l, r, delta);
+        spar.update(l, r, delta);
+        mseq.update(l, r, delta);
+        mpar.update(l, r, delta);
+    }
+    vector<pair<size_t, int> > values;
+    for(int k = 0; k < 100000; ++k)
+        values.emplace_back(rng() % n, int(rng() % 2001) - 1000);
+    for(auto &v: values)
+        big[v.first] = v.second;
+    sseq.assign(values);
+    spar.assign(values, 4);
+    mseq.assign(values);
+    mpar.assign(values, 4);
+    check(sseq, spar, big);
+    check(mseq, mpar, big);
     return 0;
 }
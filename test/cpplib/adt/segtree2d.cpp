@@ -4,8 +4,77 @@
 int32_t main()
 {
     SegTree2D<RSumQ, int> st;
-    debug(st.query(0, 0));
+    assert(st.query(0, 0) == 0);
     st.update(0, 0, 1);
-    debug(st.query(0, 0));
+    assert(st.query(0, 0) == 1);
+
+    SegTree2D<RSumQ, int> rst(3, 4);
+    rst.update(0, 1, 1, 3, 2);
+    assert(rst.query(1, 2, 0, 1) == 2);
+
+    SegTree2D<RSumQ, int> pst(vvi(3, vi(4, 1)), 2);
+    assert(pst.query(0, 2, 0, 3) == 12);
+
+    // large enough for the threaded build to split the rows.
+    vvi big(300, vi(200));
+    for(int i = 0; i < 300; ++i)
+        for(int j = 0; j < 200; ++j)
+            big[i][j] = (i * 31 + j * 17) % 23 - 11;
+    SegTree2D<RSumQ, int> seq(big), par(big, 4);
+    for(int i = 0; i < 300; i += 7)
+        for(int j = 0; j < 200; j += 11)
+            assert(par.query(i / 2, i, j / 2, j) == seq.query(i / 2, i, j / 2, j));
+
+    // a point update must merge the inner rows back, not shift them.
+    SegTree2D<RMinQ, int> col(vvi{{1}, {5}});
+    col.update(0, 0, 10);
+    assert(col.query(0, 1, 0, 0) == 5);
+
+    // point and rectangle updates against a brute force matrix (the min
+    // tree is rebuilt after the rectangle updates, which it doesn't have).
+    mt19937 rng(1);
+    for(int it = 0; it < 50; ++it) {
+        int n = rng() % 9 + 1, m = rng() % 9 + 1;
+        vvi mat(n, vi(m));
+        for(vi &row: mat)
+            for(int &x: row)
+                x = int(rng() % 21) - 10;
+        SegTree2D<RSumQ, int> bst(mat);
+        SegTree2D<RMinQ, int> mst(mat);
+        SegTree2D<RMaxQ, int> hst(mat);
+        for(int q = 0; q < 100; ++q) {
+            int l1 = rng() % n, r1 = rng() % n, l2 = rng() % m, r2 = rng() % m, x = int(rng() % 21) - 10, op = rng() % 5;
+            if(l1 > r1)
+                swap(l1, r1);
+            if(l2 > r2)
+                swap(l2, r2);
+            if(op < 2) {
+                mat[l1][l2] += x;
+                bst.update(l1, l2, x);
+                mst.update(l1, l2, x);
+                hst.update(l1, l2, x);
+            }
+            else if(op == 2) {
+                for(int i = l1; i <= r1; ++i)
+                    for(int j = l2; j <= r2; ++j)
+                        mat[i][j] += x;
+                bst.update(l1, r1, l2, r2, x);
+                mst = SegTree2D<RMinQ, int>(mat);
+                hst = SegTree2D<RMaxQ, int>(mat);
+            }
+            else {
+                int sum = 0, lo = LINF, hi = -LINF;
+                for(int i = l1; i <= r1; ++i)
+                    for(int j = l2; j <= r2; ++j) {
+                        sum += mat[i][j];
+                        lo = min(lo, mat[i][j]);
+                        hi = max(hi, mat[i][j]);
+                    }
+                assert(bst.query(l1, r1, l2, r2) == sum);
+                assert(mst.query(l1, r1, l2, r2) == lo);
+                assert(hst.query(l1, r1, l2, r2) == hi);
+            }
+        }
+    }
     return 0;
 }
@@ -0,0 +1,16 @@
+#include <cpplib/adt/segtreei.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    SegTreeI<RSumQ, int> st;
+    debug(st.query(0));
+    st.update(0, 1);
+    debug(st.query(0));
+
+    SegTreeIL<RSumQ, int> lst;
+    debug(lst.query(0));
+    lst.update(0, 0, 1);
+    debug(lst.query(0));
+    return 0;
+}
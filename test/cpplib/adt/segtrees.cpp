@@ -3,6 +3,8 @@
 
 int32_t main()
 {
+    static_assert(is_trivially_copyable<STNodeS<RSumQ, int>>::value, "nodes must be trivially copyable.");
+
     SegTreeS<RSumQ, int> st;
     debug(st.query(0));
     st.update(0, 1);
@@ -10,5 +12,7 @@ int32_t main()
     st.update(0, 1);
     st.set(0, 0);
     debug(st.query(0));
+    st.set_batch({{0, 0}}, {2});
+    debug(st.query_batch({{0, 0}}));
     return 0;
 }
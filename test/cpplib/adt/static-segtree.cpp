@@ -0,0 +1,54 @@
+#include <cpplib/adt/static-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    vi arr = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    StaticSegTree<RSumQ, int> st(arr);
+    assert(st.query(0) == 3);
+    assert(st.query(2, 9) == 35);
+
+    StaticSegTree<RMaxQ, int> mst(arr);
+    assert(mst.query(0, 10) == 9);
+    assert(mst.find(5) == 4);
+    assert(mst.find(5, false) == 10);
+    assert(mst.find(10) == arr.size());
+
+    // against a brute force, with ranges across the blocks (of 8 values)
+    // and sizes that end in a partial block.
+    mt19937 rng(1);
+    for(int it = 0; it < 200; ++it) {
+        size_t n = rng() % 100 + 1;
+        vi a(n);
+        for(int &x: a)
+            x = int(rng() % 201) - 100;
+        StaticSegTree<RSumQ, int> sst(a);
+        StaticSegTree<RMinQ, int> lst(a);
+        StaticSegTree<RMaxQ, int> hst(a);
+        for(int q = 0; q < 50; ++q) {
+            size_t l = rng() % n, r = rng() % n;
+            if(l > r)
+                swap(l, r);
+            auto first = a.begin() + l, last = a.begin() + r + 1;
+            assert(sst.query(l, r) == accumulate(first, last, 0LL));
+            assert(lst.query(l, r) == *min_element(first, last));
+            assert(hst.query(l, r) == *max_element(first, last));
+
+            int x = int(rng() % 201) - 100;
+            size_t lo = n, hi = n, llo = n, lhi = n;
+            for(size_t i = l; i <= r; ++i) {
+                if(a[i] <= x) {
+                    lo = (lo == n ? i : lo);
+                    llo = i;
+                }
+                if(a[i] >= x) {
+                    hi = (hi == n ? i : hi);
+                    lhi = i;
+                }
+            }
+            assert(lst.find(x, l, r) == lo and lst.find(x, l, r, false) == llo);
+            assert(hst.find(x, l, r) == hi and hst.find(x, l, r, false) == lhi);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,12 @@
+#include <cpplib/adt/wavelet-matrix.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    WaveletMatrix<int> wm({5, 1, 4, 1, 3});
+    debug(wm.access(2));
+    debug(wm.kth(0, 4, 2));
+    debug(wm.count_less(1, 3, 4));
+    debug(wm.count(0, 4, 1, 3));
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include <cpplib/adt/merge-sort-tree.hpp>
+#include <cpplib/adt/wavelet-matrix.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // a[l..r] kth smallest (0-indexed) and count of values less than x.
+    desync();
+    int n, q;
+    cin >> n >> q;
+
+    vi arr(n);
+    for(int &x: arr)
+        cin >> x;
+    WaveletMatrix<int> wm(arr);
+    MergeSortTree<int> mst(arr);
+    for(int i = 0; i < q; ++i) {
+        int l, r, k, x;
+        cin >> l >> r >> k >> x;
+        int ans = wm.kth(l, r, k);
+        size_t less = wm.count_less(l, r, x);
+        assert(ans == mst.kth(l, r, k) and less == mst.count_less(l, r, x));
+        cout << ans << ' ' << less << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <cpplib/adt/wide-segtree.hpp>
+#include <cpplib/stdinc.hpp>
+
+// random updates and queries against a plain loop.
+template<STKind K, typename T>
+void check(const size_t n, mt19937 &rng)
+{
+    vector<T> arr(n);
+    for(T &x: arr)
+        x = T(rng() % 2001) - 1000;
+    WideSegTree<K, T> st(arr);
+    for(int q = 0; q < 2000; ++q) {
+        size_t l = rng() % n, r = rng() % n;
+        if(l > r)
+            swap(l, r);
+        if(q % 2 == 0) {
+            T delta = T(rng() % 2001) - 1000;
+            arr[l] += delta;
+            st.update(l, delta);
+        }
+        T res = arr[l];
+        for(size_t i = l + 1; i <= r; ++i)
+            res = merge_values<T>(K, res, arr[i]);
+        assert(st.query(l, r) == res);
+        assert(st.query(l) == arr[l]);
+    }
+}
+
+int32_t main()
+{
+    WideSegTree<RSumQ, int> st;
+    assert(st.query(0) == 0);
+    st.update(0, 1);
+    assert(st.query(0) == 1);
+
+    vector<int32_t> arr(100);
+    iota(all(arr), 0);
+    WideSegTree<RMinQ, int32_t> mst(arr);
+    assert(mst.query(17, 80) == 17);
+    mst.update(50, -100);
+    assert(mst.query(17, 80) == -50);
+
+    // sizes which aren't multiples of 16, with up to 4 levels.
+    mt19937 rng(1);
+    for(size_t n: {1, 7, 17, 255, 257, 1000, 4099, 70001}) {
+        check<RSumQ, int>(n, rng);
+        check<RMinQ, int>(n, rng);
+        check<RMaxQ, int>(n, rng);
+        check<RSumQ, int32_t>(n, rng);
+        check<RMinQ, int32_t>(n, rng);
+        check<RMaxQ, int32_t>(n, rng);
+    }
+    return 0;
+}
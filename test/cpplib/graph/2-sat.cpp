@@ -0,0 +1,13 @@
+#include <cpplib/graph/2-sat.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // (x0 or x1) and (not x0 or x1) and (not x1 or x2).
+    vector<pair<int, int> > disj = {{0, 2}, {1, 2}, {3, 4}};
+    vector<bool> res = solve(3, disj);
+    assert(res.size() == 3 and res[1] and res[2]);
+    disj.emplace_back(3, 3);
+    assert(!check(3, disj));
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include <cpplib/graph/csr.hpp>
+#include <cpplib/graph/lca.hpp>
+#include <cpplib/graph/scc.hpp>
+#include <cpplib/graph/treedmtr.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // 2*(n - 1) arcs, above the parallel grain, so the threaded build runs.
+    int n = 1 << 16;
+    vector<pair<int, int> > edges;
+    for(int i = 1; i < n; ++i)
+        edges.emplace_back(i, (i - 1) / 2);
+    CSR<> tree(n, edges, true), ptree(n, edges, true, 4);
+    for(int u = 0; u < n; ++u)
+        assert(equal(all(tree[u]), ptree[u].begin(), ptree[u].end()));
+    assert(tree.arcs() == size_t(2 * (n - 1)));
+
+    LCA lca(tree, 0);
+    assert(lca.query(n - 2, n - 3) == (n - 4) / 2);
+    assert(get<2>(tree_diameter(tree)) == 16 + 15);
+
+    vector<tuple<int, int, int> > arcs = {{0, 1, 5}, {1, 2, 7}, {2, 0, 1}, {2, 3, 2}};
+    CSR<> graph(4, arcs);
+    assert(graph.weight(2)[1] == 2);
+    vector<vector<int> > comps;
+    vi repr;
+    tie(comps, repr) = scc(graph);
+    assert(comps.size() == 2 and repr[0] == repr[2] and repr[2] != repr[3]);
+    return 0;
+}
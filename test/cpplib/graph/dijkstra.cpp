@@ -0,0 +1,30 @@
+#include <cpplib/graph/dijkstra.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    vector<tuple<int, int, int> > arcs = {{0, 1, 4}, {0, 2, 1}, {2, 1, 2}, {1, 3, 1}, {2, 3, 5}, {4, 0, 1}};
+    CSR<> adj(5, arcs);
+    const int inf = numeric_limits<int>::max();
+    vi dis, pred;
+    tie(dis, pred) = dijkstra(adj, 0);
+    assert(dis == vi({0, 3, 1, 4, inf}));
+    assert(pred == vi({-1, 2, 0, 1, -1}));
+    assert(radix_dijkstra(adj, 0) == dijkstra(adj, 0));
+    assert(dial(adj, 0) == dijkstra(adj, 0));
+
+    tie(dis, pred) = dial(adj, {4, 1});
+    assert(dis == vi({1, 0, 2, 1, 0}));
+    assert(get<0>(dijkstra(adj, 0, 2))[2] == 1);
+    assert(get<0>(radix_dijkstra(adj, 0, 1))[1] == 3);
+
+    // 0-1 weights on a long path, solved by dial as a 0-1 BFS.
+    int n = 1 << 16;
+    vector<tuple<int, int, int> > path;
+    for(int i = 0; i + 1 < n; ++i)
+        path.emplace_back(i, i + 1, i % 2);
+    CSR<> line(n, path, true);
+    assert(get<0>(dial(line, 0))[n - 1] == (n - 1) / 2);
+    assert(dial(line, n / 2) == radix_dijkstra(line, n / 2));
+    return 0;
+}
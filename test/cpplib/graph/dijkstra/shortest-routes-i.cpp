@@ -0,0 +1,24 @@
+#include <cpplib/graph/dijkstra.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://cses.fi/problemset/task/1671
+    desync();
+    int n, m;
+    cin >> n >> m;
+
+    vector<tuple<int, int, int> > arcs(m);
+    for(auto &[a, b, c]: arcs) {
+        cin >> a >> b >> c;
+        a--;
+        b--;
+    }
+    CSR<> adj(n, arcs);
+
+    vi dis = get<0>(dijkstra(adj, 0));
+    assert(get<0>(radix_dijkstra(adj, 0)) == dis);
+    for(int u = 0; u < n; ++u)
+        cout << dis[u] << " \n"[u == n - 1];
+    return 0;
+}
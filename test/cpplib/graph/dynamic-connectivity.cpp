@@ -0,0 +1,15 @@
+#include <cpplib/graph/dynamic-connectivity.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    DynamicConnectivity dc(4);
+    dc.link(0, 1);
+    dc.link(1, 2);
+    dc.same(0, 2);
+    dc.cut(2, 1);
+    dc.same(0, 2);
+    dc.size();
+    debug(dc.solve());
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <cpplib/graph/dynamic-connectivity.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://codeforces.com/gym/100551/problem/A (plus "= a b" queries)
+    desync();
+    int n, k;
+    cin >> n >> k;
+
+    DynamicConnectivity dc(n);
+    vector<char> types;
+    while(k--) {
+        char t;
+        cin >> t;
+        if(t == '?') {
+            dc.size();
+            types.emplace_back(t);
+            continue;
+        }
+        int a, b;
+        cin >> a >> b;
+        a--;
+        b--;
+        if(t == '+')
+            dc.link(a, b);
+        else if(t == '-')
+            dc.cut(a, b);
+        else {
+            dc.same(a, b);
+            types.emplace_back(t);
+        }
+    }
+
+    vi res = dc.solve();
+    for(size_t i = 0; i < res.size(); ++i) {
+        if(types[i] == '?')
+            cout << res[i] << endl;
+        else
+            cout << (res[i] ? "YES" : "NO") << endl;
+    }
+    return 0;
+}
@@ -10,5 +10,22 @@ int32_t main()
             dis[i][j] = 1;
     }
     dis = floyd(dis);
+    assert(dis[0][9] == 1 and dis[9][0] == LINF);
+
+    // the matrix overload with an explicit inf, as before the flat ones.
+    vector<vector<int> > small = {{0, 4, INF}, {INF, 0, 2}, {1, INF, 0}};
+    small = floyd(small, INF);
+    assert(small[0][2] == 6 and small[2][1] == 5 and small[1][0] == 3);
+
+    // a cycle of 100 vertices, so there are many tiles.
+    int n = 100;
+    vector<int32_t> flat(n * n, 1 << 29);
+    for(int i = 0; i < n; ++i) {
+        flat[i * n + i] = 0;
+        flat[i * n + (i + 1) % n] = 1;
+    }
+    vi pred;
+    floyd(flat, pred, n, int32_t(1 << 29), 3);
+    assert(flat[5 * n + 4] == n - 1 and pred[5 * n + 4] == 3);
     return 0;
 }
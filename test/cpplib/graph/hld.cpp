@@ -0,0 +1,19 @@
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/graph/hld.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    vector<vector<int> > adj(5);
+    for(int i = 1; i < 5; ++i) {
+        adj[i - 1].emplace_back(i);
+        adj[i].emplace_back(i - 1);
+    }
+    HLD<SegTree<RSumQ, int>, int> hld(adj, vi(5, 1), 0);
+    debug(hld.query(1, 3));
+    hld.update(0, 4, 1);
+    hld.update_subtree(2, 1);
+    debug(hld.query_subtree(2));
+    debug(hld.query_batch({{0, 4}, {4, 0}}));
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <cpplib/adt/segtree.hpp>
+#include <cpplib/graph/hld.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://cses.fi/problemset/task/1138 (plus subtree sums, https://cses.fi/problemset/task/1137)
+    desync();
+    int n, q;
+    cin >> n >> q;
+
+    vi values(n);
+    for(int &v: values)
+        cin >> v;
+    vector<vector<int> > adj(n);
+    for(int i = 0; i < n - 1; ++i) {
+        int a, b;
+        cin >> a >> b;
+        a--;
+        b--;
+        adj[a].emplace_back(b);
+        adj[b].emplace_back(a);
+    }
+
+    HLD<SegTree<RSumQ, int>, int> hld(adj, values, 0);
+    while(q--) {
+        int t, s;
+        cin >> t >> s;
+        s--;
+        if(t == 1) {
+            int x;
+            cin >> x;
+            hld.update(s, x - values[s]);
+            values[s] = x;
+        }
+        else if(t == 2)
+            cout << hld.query(0, s) << endl;
+        else
+            cout << hld.query_subtree(s) << endl;
+    }
+    return 0;
+}
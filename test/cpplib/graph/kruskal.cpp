@@ -1,3 +1,4 @@
+#include <cpplib/adt/concurrent-dsu.hpp>
 #include <cpplib/graph/kruskal.hpp>
 #include <cpplib/stdinc.hpp>
 
@@ -9,5 +10,8 @@ int32_t main()
             edges.emplace_back(31, i, j);
     }
     auto res = kruskal(10, edges);
+    assert(kruskal<ConcurrentDSU>(10, edges) == res);
+    assert(filter_kruskal(10, edges) == res);
+    assert(boruvka(10, edges, 2) == res);
     return 0;
 }
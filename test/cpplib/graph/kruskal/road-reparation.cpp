@@ -0,0 +1,37 @@
+#include <cpplib/graph/csr.hpp>
+#include <cpplib/graph/kruskal.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://cses.fi/problemset/task/1675
+    desync();
+    int n, m;
+    cin >> n >> m;
+
+    vector<tuple<int, int, int> > edges(m), arcs(m);
+    for(int i = 0; i < m; ++i) {
+        int a, b, c;
+        cin >> a >> b >> c;
+        a--;
+        b--;
+        edges[i] = {c, a, b};
+        arcs[i] = {a, b, c};
+    }
+
+    auto cost = [](const vector<tuple<int, int, int> > &mst) {
+        int res = 0;
+        for(auto &e: mst)
+            res += get<0>(e);
+        return res;
+    };
+    auto res = filter_kruskal(n, edges);
+    assert(boruvka(n, edges, 3) == res);
+    assert(cost(boruvka(CSR<>(n, arcs, true), 2)) == cost(res));
+
+    if((int)res.size() != n - 1)
+        cout << "IMPOSSIBLE" << endl;
+    else
+        cout << cost(res) << endl;
+    return 0;
+}
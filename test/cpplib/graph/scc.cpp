@@ -0,0 +1,20 @@
+#include <cpplib/graph/scc.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // a long path, which a recursive dfs can't take with the default stack.
+    int n = 1000000;
+    vector<vector<int> > adj(n);
+    for(int i = 0; i + 1 < n; ++i)
+        adj[i].emplace_back(i + 1);
+    adj[n - 1].emplace_back(n / 2);
+
+    vector<vector<int> > comps;
+    vi repr;
+    tie(comps, repr) = scc(adj);
+    assert((int)comps.size() == n / 2 + 1);
+    assert(repr[0] == 0 and repr[n / 2] == repr[n - 1]);
+    assert(get<0>(scc(adj, false)).empty());
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include <cpplib/graph/csr.hpp>
+#include <cpplib/graph/scc.hpp>
+#include <cpplib/stdinc.hpp>
+
+int32_t main()
+{
+    // https://cses.fi/problemset/task/1683 (kingdoms numbered by first planet)
+    desync();
+    int n, m;
+    cin >> n >> m;
+
+    vector<pair<int, int> > arcs(m);
+    for(auto &a: arcs) {
+        cin >> a.first >> a.second;
+        a.first--;
+        a.second--;
+    }
+
+    vi repr = get<1>(scc(CSR<>(n, arcs), false));
+    vi label(n, 0);
+    int k = 0;
+    for(int u = 0; u < n; ++u) {
+        if(label[repr[u]] == 0)
+            label[repr[u]] = ++k;
+    }
+    cout << k << endl;
+    for(int u = 0; u < n; ++u)
+        cout << label[repr[u]] << " \n"[u == n - 1];
+    return 0;
+}
@@ -5,7 +5,7 @@ cd "$(dirname "${BASH_SOURCE[0]#./}")/.."
 LIB_DIR="$PWD"
 
 CXX="${CXX:-"g++-7"}"
-CXXFLAGS="-std=c++17 -pedantic -Wall -Wextra -O3"
+CXXFLAGS="-std=c++17 -pedantic -Wall -Wextra -O3 -pthread"
 DEFINE=""
 INCLUDE="-I $LIB_DIR/include"
 CPPFLAGS="$DEFINE $INCLUDE"